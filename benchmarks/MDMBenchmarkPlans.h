@@ -0,0 +1,67 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MaterialMotionRuntime.h"
+
+/** A plan whose performer does nothing. */
+@interface MDMBenchmarkNoOpPlan : NSObject <MDMPlan>
+@end
+
+/** An immutable plan whose performer does nothing. The runtime retains it instead of copying. */
+@interface MDMBenchmarkImmutablePlan : NSObject <MDMImmutablePlan>
+@end
+
+/** A plan with 64 values of state whose performer does nothing. */
+@interface MDMBenchmarkLargePlan : NSObject <MDMPlan>
+@end
+
+/** MDMBenchmarkLargePlan's state kept in copy-on-write storage. */
+@interface MDMBenchmarkCopyOnWritePlan : MDMCopyOnWritePlan <MDMPlan>
+- (nonnull instancetype)init;
+@end
+
+/** A named plan whose performer does nothing. */
+@interface MDMBenchmarkNamedPlan : NSObject <MDMNamedPlan>
+@end
+
+/** A plan whose continuous performer fetches a token and hands it to MDMBenchmarkTokens. */
+@interface MDMBenchmarkContinuousPlan : NSObject <MDMPlan>
+@end
+
+/** A plan whose composable performer emits one MDMBenchmarkNoOpPlan. */
+@interface MDMBenchmarkEmitPlan : NSObject <MDMPlan>
+@end
+
+/**
+ A plan whose frame-scheduled performer schedules itself with one token and integrates a velocity on
+ every step. The performer never comes to rest.
+ */
+@interface MDMBenchmarkSteppedPlan : NSObject <MDMPlan>
+@end
+
+/** A target with a numeric key path for MDMSpring and MDMTween plans. */
+@interface MDMBenchmarkAnimatedTarget : NSObject
+@property(nonatomic, assign) double value;
+@end
+
+/** A tracer that implements every event and does nothing. */
+@interface MDMBenchmarkNoOpTracer : NSObject <MDMTracing>
+@end
+
+/** The tokens fetched by MDMBenchmarkContinuousPlan performers, in fetch order. */
+FOUNDATION_EXTERN NSMutableArray<id<MDMTokened>> *MDMBenchmarkTokens(void);
@@ -0,0 +1,270 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMBenchmarkPlans.h"
+
+NSMutableArray<id<MDMTokened>> *MDMBenchmarkTokens(void) {
+  static NSMutableArray<id<MDMTokened>> *tokens;
+  if (!tokens) {
+    tokens = [NSMutableArray array];
+  }
+  return tokens;
+}
+
+@interface MDMBenchmarkNoOpPerformer : NSObject <MDMNamedPlanPerforming>
+@end
+
+@implementation MDMBenchmarkNoOpPerformer
+
+- (instancetype)initWithTarget:(id)target {
+  return [super init];
+}
+
+- (void)addPlan:(id<MDMPlan>)plan {
+}
+
+- (void)addPlans:(NSArray<id<MDMPlan>> *)plans {
+}
+
+- (void)addPlan:(id<MDMNamedPlan>)plan named:(NSString *)name {
+}
+
+- (void)removePlanNamed:(NSString *)name {
+}
+
+@end
+
+@interface MDMBenchmarkContinuousPerformer : NSObject <MDMContinuousPerforming>
+@end
+
+@implementation MDMBenchmarkContinuousPerformer {
+  id<MDMPlanTokenizing> _planTokenizer;
+}
+
+- (instancetype)initWithTarget:(id)target {
+  return [super init];
+}
+
+- (void)givePlanTokenizer:(id<MDMPlanTokenizing>)planTokenizer {
+  _planTokenizer = planTokenizer;
+}
+
+- (void)addPlan:(id<MDMPlan>)plan {
+  id<MDMTokened> token = [_planTokenizer tokenForPlan:plan];
+  if (token) {
+    [MDMBenchmarkTokens() addObject:token];
+  }
+}
+
+@end
+
+@interface MDMBenchmarkSteppedPerformer
+    : NSObject <MDMFrameScheduledPerforming, MDMFrameStepping>
+@end
+
+@implementation MDMBenchmarkSteppedPerformer {
+  id<MDMPlanTokenizing> _planTokenizer;
+  id<MDMFrameScheduling> _frameScheduler;
+  double _position;
+  double _velocity;
+}
+
+- (instancetype)initWithTarget:(id)target {
+  self = [super init];
+  if (self) {
+    _velocity = 1;
+  }
+  return self;
+}
+
+- (void)givePlanTokenizer:(id<MDMPlanTokenizing>)planTokenizer {
+  _planTokenizer = planTokenizer;
+}
+
+- (void)setFrameScheduler:(id<MDMFrameScheduling>)frameScheduler {
+  _frameScheduler = frameScheduler;
+}
+
+- (void)addPlan:(id<MDMPlan>)plan {
+  [_frameScheduler scheduleStepper:self token:[_planTokenizer tokenForPlan:plan]];
+}
+
+- (BOOL)stepByTimeInterval:(NSTimeInterval)interval {
+  _position += _velocity * interval;
+  _velocity *= 0.999;
+  return NO;
+}
+
+@end
+
+@interface MDMBenchmarkEmitPerformer : NSObject <MDMComposablePerforming>
+@end
+
+@implementation MDMBenchmarkEmitPerformer {
+  id<MDMPlanEmitting> _planEmitter;
+}
+
+- (instancetype)initWithTarget:(id)target {
+  return [super init];
+}
+
+- (void)setPlanEmitter:(id<MDMPlanEmitting>)planEmitter {
+  _planEmitter = planEmitter;
+}
+
+- (void)addPlan:(id<MDMPlan>)plan {
+  [_planEmitter emitPlan:[MDMBenchmarkNoOpPlan new]];
+}
+
+@end
+
+@implementation MDMBenchmarkNoOpPlan
+
+- (Class)performerClass {
+  return [MDMBenchmarkNoOpPerformer class];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return [[self class] new];
+}
+
+@end
+
+@implementation MDMBenchmarkImmutablePlan
+
+- (Class)performerClass {
+  return [MDMBenchmarkNoOpPerformer class];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return [[self class] new];
+}
+
+@end
+
+static NSMutableArray<NSNumber *> *newLargePlanState(void) {
+  NSMutableArray<NSNumber *> *state = [NSMutableArray arrayWithCapacity:64];
+  for (NSUInteger ix = 0; ix < 64; ix++) {
+    [state addObject:@(ix)];
+  }
+  return state;
+}
+
+@implementation MDMBenchmarkLargePlan {
+  NSMutableArray<NSNumber *> *_state;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _state = newLargePlanState();
+  }
+  return self;
+}
+
+- (Class)performerClass {
+  return [MDMBenchmarkNoOpPerformer class];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  MDMBenchmarkLargePlan *copy = [[self class] new];
+  copy->_state = [_state mutableCopy];
+  return copy;
+}
+
+@end
+
+@implementation MDMBenchmarkCopyOnWritePlan
+
+- (instancetype)init {
+  return [super initWithStorage:newLargePlanState()];
+}
+
+- (Class)performerClass {
+  return [MDMBenchmarkNoOpPerformer class];
+}
+
+@end
+
+@implementation MDMBenchmarkNamedPlan
+
+- (Class)performerClass {
+  return [MDMBenchmarkNoOpPerformer class];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return [[self class] new];
+}
+
+@end
+
+@implementation MDMBenchmarkContinuousPlan
+
+- (Class)performerClass {
+  return [MDMBenchmarkContinuousPerformer class];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return [[self class] new];
+}
+
+@end
+
+@implementation MDMBenchmarkEmitPlan
+
+- (Class)performerClass {
+  return [MDMBenchmarkEmitPerformer class];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return [[self class] new];
+}
+
+@end
+
+@implementation MDMBenchmarkSteppedPlan
+
+- (Class)performerClass {
+  return [MDMBenchmarkSteppedPerformer class];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return [[self class] new];
+}
+
+@end
+
+@implementation MDMBenchmarkAnimatedTarget
+@end
+
+@implementation MDMBenchmarkNoOpTracer
+
+- (void)didAddPlan:(id<MDMPlan>)plan to:(id)target {
+}
+
+- (void)didAddPlans:(NSArray<id<MDMPlan>> *)plans to:(id)target {
+}
+
+- (void)didAddPlan:(id<MDMNamedPlan>)plan named:(NSString *)name to:(id)target {
+}
+
+- (void)didRemovePlanNamed:(NSString *)name from:(id)target {
+}
+
+- (void)didCreatePerformer:(id<MDMPerforming>)performer for:(id)target {
+}
+
+@end
@@ -0,0 +1,489 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+/*
+ Headless microbenchmarks for the runtime's core operations.
+
+ Every case is run against 1, 1k and 100k targets unless it lists its own target counts. Each
+ result is printed to stdout as one JSON object per line:
+
+   {"benchmark":"addPlan","targets":1000,"operations":100000,"ns_per_op":112.4,"allocations_per_op":6.0}
+
+ allocations_per_op is null on platforms where allocations can't be counted.
+
+ Usage: mdm-benchmarks [--filter <substring>] [--max-targets <count>]
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <stdio.h>
+#import <string.h>
+
+#import "MDMBenchmarkPlans.h"
+#import "MaterialMotionRuntime.h"
+#import "private/MDMMonotonicTime.h"
+
+#pragma mark - Allocation counting
+
+#if defined(__GLIBC__)
+
+#define MDM_COUNTS_ALLOCATIONS 1
+
+#import <errno.h>
+#import <stdatomic.h>
+
+// Interpose the allocator's entry points so that heap allocations made by the process, including
+// those of the tracer thread and libdispatch, are counted. Deallocations are not counted.
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+
+static _Atomic uint64_t allocationCount;
+
+static inline void countAllocation(void) {
+  atomic_fetch_add_explicit(&allocationCount, 1, memory_order_relaxed);
+}
+
+void *malloc(size_t size) {
+  countAllocation();
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+  countAllocation();
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) {
+  countAllocation();
+  return __libc_realloc(pointer, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+  countAllocation();
+  return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+  countAllocation();
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **pointer, size_t alignment, size_t size) {
+  if (alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0) {
+    return EINVAL;
+  }
+  countAllocation();
+  void *allocation = __libc_memalign(alignment, size);
+  if (!allocation && size > 0) {
+    return ENOMEM;
+  }
+  *pointer = allocation;
+  return 0;
+}
+
+static uint64_t currentAllocationCount(void) {
+  return atomic_load_explicit(&allocationCount, memory_order_relaxed);
+}
+
+#else
+
+#define MDM_COUNTS_ALLOCATIONS 0
+
+static uint64_t currentAllocationCount(void) {
+  return 0;
+}
+
+#endif
+
+#pragma mark - Measurement
+
+// The minimum number of operations performed by each case, regardless of target count.
+static const NSUInteger kMinimumOperations = 100000;
+
+typedef struct {
+  uint64_t nanoseconds;
+  uint64_t allocations;
+} MDMMeasurement;
+
+// Measures a block of work. Only the work inside the block is counted.
+static void measure(MDMMeasurement *measurement, void (^work)(void)) {
+  uint64_t allocationsBefore = currentAllocationCount();
+  uint64_t start = MDMMonotonicTimeNanoseconds();
+  work();
+  measurement->nanoseconds += MDMMonotonicTimeNanoseconds() - start;
+  measurement->allocations += currentAllocationCount() - allocationsBefore;
+}
+
+static void report(const char *name, NSUInteger targetCount, NSUInteger operations,
+                   MDMMeasurement measurement) {
+  double nsPerOp = (double)measurement.nanoseconds / (double)operations;
+  if (MDM_COUNTS_ALLOCATIONS) {
+    double allocationsPerOp = (double)measurement.allocations / (double)operations;
+    printf("{\"benchmark\":\"%s\",\"targets\":%lu,\"operations\":%lu,\"ns_per_op\":%.1f,"
+           "\"allocations_per_op\":%.2f}\n",
+           name, (unsigned long)targetCount, (unsigned long)operations, nsPerOp, allocationsPerOp);
+  } else {
+    printf("{\"benchmark\":\"%s\",\"targets\":%lu,\"operations\":%lu,\"ns_per_op\":%.1f,"
+           "\"allocations_per_op\":null}\n",
+           name, (unsigned long)targetCount, (unsigned long)operations, nsPerOp);
+  }
+  fflush(stdout);
+}
+
+static NSArray *makeTargets(NSUInteger count) {
+  NSMutableArray *targets = [NSMutableArray arrayWithCapacity:count];
+  for (NSUInteger ix = 0; ix < count; ix++) {
+    [targets addObject:[NSObject new]];
+  }
+  return targets;
+}
+
+static NSUInteger operationsForTargetCount(NSUInteger targetCount) {
+  return MAX(kMinimumOperations, targetCount);
+}
+
+#pragma mark - Cases
+
+// The number of target counts each case is run against.
+enum { kTargetCountsPerCase = 3 };
+
+typedef NSUInteger (*MDMBenchmarkCase)(NSUInteger targetCount, MDMMeasurement *measurement);
+
+// addPlan:to: with one plan per operation, spread round-robin across the targets.
+static NSUInteger benchmarkAddPlan(NSUInteger targetCount, MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger operations = operationsForTargetCount(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMBenchmarkNoOpPlan *plan = [MDMBenchmarkNoOpPlan new];
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < operations; ix++) {
+      [runtime addPlan:plan to:targets[ix % targetCount]];
+    }
+  });
+  return operations;
+}
+
+// addPlan:to: of a plan that is retained rather than copied. Compare with addPlan.
+static NSUInteger benchmarkAddImmutablePlan(NSUInteger targetCount, MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger operations = operationsForTargetCount(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMBenchmarkImmutablePlan *plan = [MDMBenchmarkImmutablePlan new];
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < operations; ix++) {
+      [runtime addPlan:plan to:targets[ix % targetCount]];
+    }
+  });
+  return operations;
+}
+
+// addPlan:to: of a plan with 64 values of state that is copied in full.
+static NSUInteger benchmarkAddLargePlan(NSUInteger targetCount, MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger operations = operationsForTargetCount(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMBenchmarkLargePlan *plan = [MDMBenchmarkLargePlan new];
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < operations; ix++) {
+      [runtime addPlan:plan to:targets[ix % targetCount]];
+    }
+  });
+  return operations;
+}
+
+// addPlan:to: of the same state held in copy-on-write storage. Compare with addLargePlan.
+static NSUInteger benchmarkAddCopyOnWritePlan(NSUInteger targetCount,
+                                              MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger operations = operationsForTargetCount(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMBenchmarkCopyOnWritePlan *plan = [MDMBenchmarkCopyOnWritePlan new];
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < operations; ix++) {
+      [runtime addPlan:plan to:targets[ix % targetCount]];
+    }
+  });
+  return operations;
+}
+
+// addPlans:to: with batches of batchSize plans, delivered to the performer in one addPlans:
+// invocation. One operation is one plan, so ns_per_op is the per-plan cost.
+static NSUInteger runAddPlansBatched(NSUInteger batchSize,
+                                     NSUInteger targetCount,
+                                     MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger batches = MAX(operationsForTargetCount(targetCount) / batchSize, (NSUInteger)1);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  NSMutableArray *plans = [NSMutableArray array];
+  for (NSUInteger ix = 0; ix < batchSize; ix++) {
+    [plans addObject:[MDMBenchmarkNoOpPlan new]];
+  }
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < batches; ix++) {
+      [runtime addPlans:plans to:targets[ix % targetCount]];
+    }
+  });
+  return batches * batchSize;
+}
+
+// Compare with addPlan.
+static NSUInteger benchmarkAddPlansBatched1(NSUInteger targetCount, MDMMeasurement *measurement) {
+  return runAddPlansBatched(1, targetCount, measurement);
+}
+
+static NSUInteger benchmarkAddPlansBatched10(NSUInteger targetCount,
+                                             MDMMeasurement *measurement) {
+  return runAddPlansBatched(10, targetCount, measurement);
+}
+
+static NSUInteger benchmarkAddPlansBatched100(NSUInteger targetCount,
+                                              MDMMeasurement *measurement) {
+  return runAddPlansBatched(100, targetCount, measurement);
+}
+
+static NSUInteger benchmarkAddPlansBatched1000(NSUInteger targetCount,
+                                               MDMMeasurement *measurement) {
+  return runAddPlansBatched(1000, targetCount, measurement);
+}
+
+// addPlan:named:to: replacing the same named plan on each target over and over.
+static NSUInteger benchmarkNamedPlanReplace(NSUInteger targetCount, MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger operations = operationsForTargetCount(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMBenchmarkNamedPlan *plan = [MDMBenchmarkNamedPlan new];
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < operations; ix++) {
+      [runtime addPlan:plan named:@"drag" to:targets[ix % targetCount]];
+    }
+  });
+  return operations;
+}
+
+// addPlan:withName:to: with an interned name. Compare with namedPlanReplace.
+static NSUInteger benchmarkInternedNamedPlanReplace(NSUInteger targetCount,
+                                                    MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger operations = operationsForTargetCount(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMBenchmarkNamedPlan *plan = [MDMBenchmarkNamedPlan new];
+  MDMPlanName *name = [MDMPlanName planNameWithString:@"drag"];
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < operations; ix++) {
+      [runtime addPlan:plan withName:name to:targets[ix % targetCount]];
+    }
+  });
+  return operations;
+}
+
+// removePlanNamed:from: for named plans that exist. Plans are re-added outside of the measurement.
+static NSUInteger benchmarkRemovePlanNamed(NSUInteger targetCount, MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger rounds = operationsForTargetCount(targetCount) / targetCount;
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMBenchmarkNamedPlan *plan = [MDMBenchmarkNamedPlan new];
+  for (NSUInteger round = 0; round < rounds; round++) {
+    for (id target in targets) {
+      [runtime addPlan:plan named:@"drag" to:target];
+    }
+    measure(measurement, ^{
+      for (id target in targets) {
+        [runtime removePlanNamed:@"drag" from:target];
+      }
+    });
+  }
+  return rounds * targetCount;
+}
+
+// removePlanNamed:from: for targets that have never received a plan.
+static NSUInteger benchmarkRemoveMissingPlanNamed(NSUInteger targetCount,
+                                                  MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger operations = operationsForTargetCount(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < operations; ix++) {
+      [runtime removePlanNamed:@"drag" from:targets[ix % targetCount]];
+    }
+  });
+  return operations;
+}
+
+// Activates and then deactivates every token. One operation is one activation or deactivation.
+static NSUInteger benchmarkTokenStorm(NSUInteger targetCount, MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  [MDMBenchmarkTokens() removeAllObjects];
+  for (id target in targets) {
+    [runtime addPlan:[MDMBenchmarkContinuousPlan new] to:target];
+  }
+  NSArray<id<MDMTokened>> *tokens = [MDMBenchmarkTokens() copy];
+  NSUInteger rounds = MAX((NSUInteger)1, operationsForTargetCount(targetCount) / (2 * tokens.count));
+  measure(measurement, ^{
+    for (NSUInteger round = 0; round < rounds; round++) {
+      for (id<MDMTokened> token in tokens) {
+        token.active = YES;
+      }
+      for (id<MDMTokened> token in tokens) {
+        token.active = NO;
+      }
+    }
+  });
+  [MDMBenchmarkTokens() removeAllObjects];
+  return rounds * 2 * tokens.count;
+}
+
+// addPlan:to: of a plan whose performer emits one further plan through MDMPlanEmitter.
+static NSUInteger benchmarkComposition(NSUInteger targetCount, MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger operations = operationsForTargetCount(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMBenchmarkEmitPlan *plan = [MDMBenchmarkEmitPlan new];
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < operations; ix++) {
+      [runtime addPlan:plan to:targets[ix % targetCount]];
+    }
+  });
+  return operations;
+}
+
+// addPlan:to: with four tracers that implement every event. Compare with addPlan.
+static NSUInteger benchmarkTracerOverhead(NSUInteger targetCount, MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  NSUInteger operations = operationsForTargetCount(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  for (int ix = 0; ix < 4; ix++) {
+    [runtime addTracer:[MDMBenchmarkNoOpTracer new]];
+  }
+  MDMBenchmarkNoOpPlan *plan = [MDMBenchmarkNoOpPlan new];
+  measure(measurement, ^{
+    for (NSUInteger ix = 0; ix < operations; ix++) {
+      [runtime addPlan:plan to:targets[ix % targetCount]];
+    }
+  });
+  return operations;
+}
+
+// One tick of the runtime's frame clock with one scheduled stepper per target. One operation is one
+// frame, so ns_per_op is the per-frame cost of stepping every active performer.
+static NSUInteger benchmarkFrameTick(NSUInteger targetCount, MDMMeasurement *measurement) {
+  NSArray *targets = makeTargets(targetCount);
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMVirtualClock *clock = [MDMVirtualClock new];
+  runtime.frameClock = clock;
+  for (id target in targets) {
+    [runtime addPlan:[MDMBenchmarkSteppedPlan new] to:target];
+  }
+  // Every count steps roughly the same number of performers in total.
+  NSUInteger frames = MAX((NSUInteger)100, 10 * kMinimumOperations / targetCount);
+  measure(measurement, ^{
+    for (NSUInteger frame = 0; frame < frames; frame++) {
+      [clock advanceBy:1.0 / 60.0];
+    }
+  });
+  return frames;
+}
+
+// One tick of the runtime's frame clock with one undamped MDMSpring per target, all integrated by
+// the built-in motion solver. One operation is one frame. Compare with frameTick.
+static NSUInteger benchmarkSolvedSprings(NSUInteger targetCount, MDMMeasurement *measurement) {
+  MDMMotionRuntime *runtime = [MDMMotionRuntime new];
+  MDMVirtualClock *clock = [MDMVirtualClock new];
+  runtime.frameClock = clock;
+  NSMutableArray *targets = [NSMutableArray arrayWithCapacity:targetCount];
+  // Without damping the springs oscillate forever.
+  MDMSpring *spring =
+      [[MDMSpring alloc] initWithKeyPath:@"value" destination:1000 stiffness:1 damping:0];
+  for (NSUInteger ix = 0; ix < targetCount; ix++) {
+    MDMBenchmarkAnimatedTarget *target = [MDMBenchmarkAnimatedTarget new];
+    [targets addObject:target];
+    [runtime addPlan:spring to:target];
+  }
+  NSUInteger frames = MAX((NSUInteger)100, 10 * kMinimumOperations / targetCount);
+  measure(measurement, ^{
+    for (NSUInteger frame = 0; frame < frames; frame++) {
+      [clock advanceBy:1.0 / 60.0];
+    }
+  });
+  return frames;
+}
+
+#pragma mark - Main
+
+int main(int argc, const char *argv[]) {
+  const char *filter = NULL;
+  NSUInteger maxTargets = NSUIntegerMax;
+  for (int ix = 1; ix < argc; ix++) {
+    if (strcmp(argv[ix], "--filter") == 0 && ix + 1 < argc) {
+      filter = argv[++ix];
+    } else if (strcmp(argv[ix], "--max-targets") == 0 && ix + 1 < argc) {
+      maxTargets = (NSUInteger)strtoull(argv[++ix], NULL, 10);
+    } else {
+      fprintf(stderr, "usage: %s [--filter <substring>] [--max-targets <count>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Frame ticks are measured at the numbers of simultaneously animating performers of interest.
+  static const NSUInteger frameTickTargetCounts[kTargetCountsPerCase] = {10, 1000, 10000};
+  static const NSUInteger defaultTargetCounts[kTargetCountsPerCase] = {1, 1000, 100000};
+
+  struct {
+    const char *name;
+    MDMBenchmarkCase run;
+    // NULL to use defaultTargetCounts.
+    const NSUInteger *targetCounts;
+  } cases[] = {
+      {"addPlan", benchmarkAddPlan},
+      {"addImmutablePlan", benchmarkAddImmutablePlan},
+      {"addLargePlan", benchmarkAddLargePlan},
+      {"addCopyOnWritePlan", benchmarkAddCopyOnWritePlan},
+      {"addPlansBatched1", benchmarkAddPlansBatched1},
+      {"addPlansBatched10", benchmarkAddPlansBatched10},
+      {"addPlansBatched100", benchmarkAddPlansBatched100},
+      {"addPlansBatched1000", benchmarkAddPlansBatched1000},
+      {"namedPlanReplace", benchmarkNamedPlanReplace},
+      {"internedNamedPlanReplace", benchmarkInternedNamedPlanReplace},
+      {"removePlanNamed", benchmarkRemovePlanNamed},
+      {"removeMissingPlanNamed", benchmarkRemoveMissingPlanNamed},
+      {"tokenStorm", benchmarkTokenStorm},
+      {"composition", benchmarkComposition},
+      {"tracerOverhead", benchmarkTracerOverhead},
+      {"frameTick", benchmarkFrameTick, frameTickTargetCounts},
+      {"solvedSprings", benchmarkSolvedSprings, frameTickTargetCounts},
+  };
+
+  for (size_t caseIndex = 0; caseIndex < sizeof(cases) / sizeof(cases[0]); caseIndex++) {
+    if (filter && !strstr(cases[caseIndex].name, filter)) {
+      continue;
+    }
+    const NSUInteger *targetCounts = cases[caseIndex].targetCounts ?: defaultTargetCounts;
+    for (size_t countIndex = 0; countIndex < kTargetCountsPerCase; countIndex++) {
+      NSUInteger targetCount = targetCounts[countIndex];
+      if (targetCount > maxTargets) {
+        continue;
+      }
+      @autoreleasepool {
+        MDMMeasurement measurement = {0, 0};
+        NSUInteger operations = cases[caseIndex].run(targetCount, &measurement);
+        report(cases[caseIndex].name, targetCount, operations, measurement);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMTracing.h"
+
+/**
+ A binary trace recorder writes every Tracing event as a fixed-size binary record into a
+ preallocated memory-mapped file.
+
+ Each record holds a monotonic timestamp, the event type, a number identifying the target, and
+ interned IDs for the target's class, the plan class, the performer class and the plan name. Each
+ class and plan name is written once to a string table at the end of the file. Records are stored
+ in a ring buffer: once the file is full the oldest records are overwritten.
+
+ Because the file is memory-mapped, recorded events survive a crash of the process. Captures can be
+ summarized offline with the decoder in tools/trace-decoder.
+
+ A recorder should only be added to a single runtime.
+ */
+NS_SWIFT_NAME(BinaryTraceRecorder)
+@interface MDMBinaryTraceRecorder : NSObject <MDMTracing>
+
+/**
+ Creates the capture file at the given path, replacing any existing file.
+
+ @param path The path of the capture file.
+ @param recordCapacity The number of records the ring buffer can hold.
+ @param error Populated if the file could not be created or mapped.
+ */
+- (nullable instancetype)initWithPath:(nonnull NSString *)path
+                       recordCapacity:(NSUInteger)recordCapacity
+                                error:(NSError *_Nullable *_Nullable)error
+    NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/** The path of the capture file. */
+@property(nonatomic, copy, nonnull, readonly) NSString *path;
+
+/** The total number of records written, including records that have since been overwritten. */
+@property(nonatomic, assign, readonly) uint64_t recordCount;
+
+/**
+ Flushes the capture to disk and unmaps the file.
+
+ Events received after closing are ignored. Invoked automatically on dealloc.
+ */
+- (void)close;
+
+@end
@@ -0,0 +1,271 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMBinaryTraceRecorder.h"
+
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+
+#import "MDMPlan.h"
+#import "private/MDMBinaryTraceFormat.h"
+#import "private/MDMMonotonicTime.h"
+
+// The number of bytes reserved for interned strings.
+static const uint32_t kStringTableCapacity = 256 * 1024;
+
+@implementation MDMBinaryTraceRecorder {
+  int _fileDescriptor;
+  void *_mapping;
+  size_t _mappingLength;
+
+  MDMBinaryTraceHeader *_header;
+  MDMBinaryTraceRecord *_records;
+  uint8_t *_stringTable;
+
+  // String identifiers and target identifiers are allocated independently.
+  uint32_t _nextIdentifier;
+  uint32_t _nextTargetIdentifier;
+
+  // The values of these map tables are identifiers stored as integers, so lookups neither send
+  // messages nor box numbers.
+  NSMapTable *_classToIdentifier;
+  NSMapTable *_targetToIdentifier;
+  NSMapTable *_planNameToIdentifier;
+}
+
+- (instancetype)initWithPath:(NSString *)path
+              recordCapacity:(NSUInteger)recordCapacity
+                       error:(NSError **)error {
+  NSParameterAssert(recordCapacity > 0 && recordCapacity <= UINT32_MAX);
+  self = [super init];
+  if (self) {
+    _path = [path copy];
+    _fileDescriptor = -1;
+
+    size_t recordsLength = recordCapacity * sizeof(MDMBinaryTraceRecord);
+    _mappingLength = sizeof(MDMBinaryTraceHeader) + recordsLength + kStringTableCapacity;
+
+    _fileDescriptor = open(path.fileSystemRepresentation, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (_fileDescriptor < 0 || ftruncate(_fileDescriptor, (off_t)_mappingLength) != 0) {
+      return [self failWithError:error];
+    }
+    _mapping = mmap(NULL, _mappingLength, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+    if (_mapping == MAP_FAILED) {
+      _mapping = NULL;
+      return [self failWithError:error];
+    }
+
+    _header = (MDMBinaryTraceHeader *)_mapping;
+    _records = (MDMBinaryTraceRecord *)(_header + 1);
+    _stringTable = (uint8_t *)(_records + recordCapacity);
+
+    _header->magic = MDM_BINARY_TRACE_MAGIC;
+    _header->version = MDM_BINARY_TRACE_VERSION;
+    _header->headerSize = (uint16_t)sizeof(MDMBinaryTraceHeader);
+    _header->recordSize = (uint32_t)sizeof(MDMBinaryTraceRecord);
+    _header->recordCapacity = (uint32_t)recordCapacity;
+    _header->stringTableCapacity = kStringTableCapacity;
+    _header->startTimestamp = MDMMonotonicTimeNanoseconds();
+
+    _nextIdentifier = 1;
+    _nextTargetIdentifier = 1;
+    NSPointerFunctionsOptions identifierOptions =
+        NSPointerFunctionsOpaqueMemory | NSPointerFunctionsIntegerPersonality;
+    _classToIdentifier =
+        [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsOpaqueMemory
+                                                | NSPointerFunctionsOpaquePersonality)
+                                  valueOptions:identifierOptions
+                                      capacity:0];
+    _targetToIdentifier =
+        [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsWeakMemory
+                                                | NSPointerFunctionsObjectPointerPersonality)
+                                  valueOptions:identifierOptions
+                                      capacity:0];
+    _planNameToIdentifier =
+        [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsStrongMemory
+                                                | NSPointerFunctionsCopyIn)
+                                  valueOptions:identifierOptions
+                                      capacity:0];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self close];
+}
+
+#pragma mark - Public
+
+- (uint64_t)recordCount {
+  return _header ? _header->recordsWritten : 0;
+}
+
+- (void)close {
+  if (_mapping) {
+    msync(_mapping, _mappingLength, MS_SYNC);
+    munmap(_mapping, _mappingLength);
+    _mapping = NULL;
+    _header = NULL;
+    _records = NULL;
+    _stringTable = NULL;
+  }
+  if (_fileDescriptor >= 0) {
+    close(_fileDescriptor);
+    _fileDescriptor = -1;
+  }
+}
+
+#pragma mark - Private
+
+- (instancetype)failWithError:(NSError **)error {
+  if (error) {
+    *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+  }
+  [self close];
+  return nil;
+}
+
+- (void)writeEvent:(MDMBinaryTraceEvent)event
+            target:(id)target
+       planClassID:(uint32_t)planClassID
+  performerClassID:(uint32_t)performerClassID
+            nameID:(uint32_t)nameID {
+  if (!_header) {
+    return;
+  }
+  uint32_t targetClassID = 0;
+  uint32_t targetID = [self identifierForTarget:target targetClassID:&targetClassID];
+
+  uint64_t index = _header->recordsWritten % _header->recordCapacity;
+  MDMBinaryTraceRecord *record = &_records[index];
+  record->timestamp = MDMMonotonicTimeNanoseconds();
+  record->event = (uint16_t)event;
+  record->reserved = 0;
+  record->targetID = targetID;
+  record->planClassID = planClassID;
+  record->performerClassID = performerClassID;
+  record->nameID = nameID;
+  record->targetClassID = targetClassID;
+  _header->recordsWritten++;
+}
+
+- (uint32_t)appendString:(NSString *)string kind:(MDMBinaryTraceStringKind)kind {
+  uint32_t identifier = _nextIdentifier++;
+  if (!_header) {
+    return identifier;
+  }
+
+  const char *utf8 = string.UTF8String;
+  size_t length = strlen(utf8);
+  if (length > UINT16_MAX) {
+    length = UINT16_MAX;
+  }
+  size_t paddedLength = (length + 3) & ~(size_t)3;
+  size_t entryLength = sizeof(MDMBinaryTraceString) + paddedLength;
+  if (_header->stringTableLength + entryLength > _header->stringTableCapacity) {
+    _header->flags |= MDMBinaryTraceFlagStringTableOverflow;
+    return identifier;
+  }
+
+  uint8_t *cursor = _stringTable + _header->stringTableLength;
+  MDMBinaryTraceString entry = {identifier, (uint16_t)kind, (uint16_t)length};
+  memcpy(cursor, &entry, sizeof(entry));
+  memcpy(cursor + sizeof(entry), utf8, length);
+  memset(cursor + sizeof(entry) + length, 0, paddedLength - length);
+  _header->stringTableLength += (uint32_t)entryLength;
+  return identifier;
+}
+
+- (uint32_t)identifierForClass:(Class)aClass {
+  uint32_t identifier = (uint32_t)(uintptr_t)NSMapGet(_classToIdentifier, (__bridge void *)aClass);
+  if (identifier == 0) {
+    identifier = [self appendString:NSStringFromClass(aClass) kind:MDMBinaryTraceStringKindClass];
+    NSMapInsert(_classToIdentifier, (__bridge void *)aClass, (void *)(uintptr_t)identifier);
+  }
+  return identifier;
+}
+
+// Targets are numbered in order of first appearance. Only their class name is interned, once per
+// class, so the string table's size doesn't grow with the number of targets.
+- (uint32_t)identifierForTarget:(id)target targetClassID:(uint32_t *)targetClassID {
+  *targetClassID = [self identifierForClass:[target class]];
+  uint32_t identifier = (uint32_t)(uintptr_t)NSMapGet(_targetToIdentifier, (__bridge void *)target);
+  if (identifier == 0) {
+    identifier = _nextTargetIdentifier++;
+    NSMapInsert(_targetToIdentifier, (__bridge void *)target, (void *)(uintptr_t)identifier);
+  }
+  return identifier;
+}
+
+- (uint32_t)identifierForPlanName:(NSString *)name {
+  uint32_t identifier = (uint32_t)(uintptr_t)NSMapGet(_planNameToIdentifier, (__bridge void *)name);
+  if (identifier == 0) {
+    identifier = [self appendString:name kind:MDMBinaryTraceStringKindPlanName];
+    NSMapInsert(_planNameToIdentifier, (__bridge void *)name, (void *)(uintptr_t)identifier);
+  }
+  return identifier;
+}
+
+- (void)writeEvent:(MDMBinaryTraceEvent)event
+              plan:(id<MDMPlan>)plan
+              name:(NSString *)name
+            target:(id)target {
+  [self writeEvent:event
+                target:target
+           planClassID:[self identifierForClass:[plan class]]
+      performerClassID:[self identifierForClass:[plan performerClass]]
+                nameID:name ? [self identifierForPlanName:name] : 0];
+}
+
+#pragma mark - MDMTracing
+
+- (void)didAddPlan:(id<MDMPlan>)plan to:(id)target {
+  [self writeEvent:MDMBinaryTraceEventDidAddPlan plan:plan name:nil target:target];
+}
+
+- (void)didAddPlans:(NSArray<id<MDMPlan>> *)plans to:(id)target {
+  for (id<MDMPlan> plan in plans) {
+    [self writeEvent:MDMBinaryTraceEventDidAddPlan plan:plan name:nil target:target];
+  }
+}
+
+- (void)didAddPlan:(id<MDMNamedPlan>)plan named:(NSString *)name to:(id)target {
+  [self writeEvent:MDMBinaryTraceEventDidAddPlanNamed plan:plan name:name target:target];
+}
+
+- (void)didRemovePlanNamed:(NSString *)name from:(id)target {
+  [self writeEvent:MDMBinaryTraceEventDidRemovePlanNamed
+                target:target
+           planClassID:0
+      performerClassID:0
+                nameID:[self identifierForPlanName:name]];
+}
+
+- (void)didCreatePerformer:(id<MDMPerforming>)performer for:(id)target {
+  [self writeEvent:MDMBinaryTraceEventDidCreatePerformer
+                target:target
+           planClassID:0
+      performerClassID:[self identifierForClass:[performer class]]
+                nameID:0];
+}
+
+- (void)didDropEmittedPlan:(id<MDMPlan>)plan to:(id)target {
+  [self writeEvent:MDMBinaryTraceEventDidDropEmittedPlan plan:plan name:nil target:target];
+}
+
+@end
@@ -0,0 +1,47 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@protocol MDMClockObserving;
+
+/**
+ A clock provides a monotonic time source and a stream of ticks.
+
+ Ticks are the points at which time-driven work, such as coalesced notifications, is performed.
+ */
+NS_SWIFT_NAME(Clock)
+@protocol MDMClock <NSObject>
+
+/** The current time of the clock, in seconds. Never decreases. */
+@property(nonatomic, assign, readonly) NSTimeInterval currentTime;
+
+/** Adds an observer that is informed of every tick. Observers are weakly held. */
+- (void)addClockObserver:(nonnull id<MDMClockObserving>)observer;
+
+/** Removes an observer. Does nothing if the observer was not added. */
+- (void)removeClockObserver:(nonnull id<MDMClockObserving>)observer;
+
+@end
+
+/** A clock observer receives tick events from an MDMClock. */
+NS_SWIFT_NAME(ClockObserving)
+@protocol MDMClockObserving <NSObject>
+
+/** Informs the receiver that the clock has ticked. */
+- (void)clockDidTick:(nonnull id<MDMClock>)clock;
+
+@end
@@ -18,11 +18,34 @@
 
 #import "MDMTracing.h"
 
+/**
+ A log sink receives one block per traced event.
+
+ Invoking the block formats and returns the event's message. Sinks that discard an event should not
+ invoke the block, in which case no formatting work is done.
+ */
+typedef void (^MDMConsoleLoggingTracerSink)(NSString *_Nonnull (^_Nonnull formatMessage)(void))
+    NS_SWIFT_NAME(ConsoleLoggingTracerSink);
+
 /**
  An instance of a logging tracer added to a MotionRuntime instance will output all Tracing
  invocation names and parameters to the console.
+
+ The properties of each plan class are reflected once, on first sight, and their values are read
+ through the cached getter implementations.
  */
 NS_SWIFT_NAME(ConsoleLoggingTracer)
 @interface MDMConsoleLoggingTracer : NSObject <MDMTracing>
 
+/** Initializes a tracer that writes every message to the console with NSLog. */
+- (nonnull instancetype)init;
+
+/**
+ Initializes a tracer that hands each event to the provided sink.
+
+ Messages are only formatted if the sink invokes the provided block.
+ */
+- (nonnull instancetype)initWithSink:(nonnull MDMConsoleLoggingTracerSink)sink
+    NS_DESIGNATED_INITIALIZER;
+
 @end
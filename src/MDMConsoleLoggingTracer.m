@@ -18,61 +18,174 @@
 
 #import <objc/runtime.h>
 
-static NSString *debugDescriptionOfPlanProperties(NSObject<MDMPlan> *plan) {
-  NSMutableArray *propertyDescriptions = [NSMutableArray array];
+#import "MDMPlan.h"
+
+// A property of a plan class along with everything needed to read and describe its value.
+@interface MDMPlanPropertySchema : NSObject
+@property(nonatomic, copy) NSString *name;
+@property(nonatomic, copy) NSString *typeName;
+@property(nonatomic, assign) SEL getter;
+@property(nonatomic, assign) IMP getterImplementation;
+@property(nonatomic, assign) char typeEncoding;
+@end
+
+@implementation MDMPlanPropertySchema
+@end
+
+static NSArray<MDMPlanPropertySchema *> *propertySchemasOfClass(Class planClass) {
+  NSMutableArray<MDMPlanPropertySchema *> *schemas = [NSMutableArray array];
   unsigned int numberOfProperties = 0;
-  objc_property_t *properties = class_copyPropertyList([plan class], &numberOfProperties);
+  objc_property_t *properties = class_copyPropertyList(planClass, &numberOfProperties);
   for (unsigned int ix = 0; ix < numberOfProperties; ix++) {
     objc_property_t property = properties[ix];
     const char *propName = property_getName(property);
-    if (propName) {
-      NSString *propertyName = [NSString stringWithCString:propName
-                                                  encoding:[NSString defaultCStringEncoding]];
-      const char *attributes = property_getAttributes(property);
-      NSString *propertyType = [NSString stringWithCString:attributes
-                                                  encoding:[NSString defaultCStringEncoding]];
-      NSArray *propertyTypeComponents = [propertyType componentsSeparatedByString:@"\""];
-      if ([propertyTypeComponents count] > 1) {
-        propertyType = propertyTypeComponents[1];
-      } else {
-        propertyType = @"@";
-      }
-
-      [propertyDescriptions addObject:[NSString stringWithFormat:
-                                                    @"  %@: %@ = %@",
-                                                    propertyName,
-                                                    propertyType,
-                                                    [plan valueForKey:propertyName]]];
+    if (!propName) {
+      continue;
+    }
+    MDMPlanPropertySchema *schema = [MDMPlanPropertySchema new];
+    schema.name = [NSString stringWithCString:propName encoding:[NSString defaultCStringEncoding]];
+
+    // The type encoding follows the leading T of the attribute string, e.g. T@"NSString",&,N,V_name
+    const char *attributes = property_getAttributes(property);
+    schema.typeEncoding = (attributes && attributes[0] == 'T') ? attributes[1] : '@';
+    NSString *propertyType = [NSString stringWithCString:attributes
+                                                encoding:[NSString defaultCStringEncoding]];
+    NSArray *propertyTypeComponents = [propertyType componentsSeparatedByString:@"\""];
+    if ([propertyTypeComponents count] > 1) {
+      schema.typeName = propertyTypeComponents[1];
+    } else {
+      schema.typeName = @"@";
     }
+
+    char *customGetter = property_copyAttributeValue(property, "G");
+    schema.getter = sel_registerName(customGetter ? customGetter : propName);
+    free(customGetter);
+    schema.getterImplementation = class_getMethodImplementation(planClass, schema.getter);
+
+    [schemas addObject:schema];
   }
   free(properties);
+  return schemas;
+}
+
+static id valueOfProperty(NSObject *plan, MDMPlanPropertySchema *schema) {
+  IMP imp = schema.getterImplementation;
+  SEL getter = schema.getter;
+  switch (schema.typeEncoding) {
+    case '@':
+      return ((id(*)(id, SEL))imp)(plan, getter);
+    case 'B':
+      return @(((bool (*)(id, SEL))imp)(plan, getter));
+    case 'c':
+      return @(((char (*)(id, SEL))imp)(plan, getter));
+    case 'i':
+      return @(((int (*)(id, SEL))imp)(plan, getter));
+    case 'l':
+      return @(((long (*)(id, SEL))imp)(plan, getter));
+    case 'q':
+      return @(((long long (*)(id, SEL))imp)(plan, getter));
+    case 'I':
+      return @(((unsigned int (*)(id, SEL))imp)(plan, getter));
+    case 'L':
+      return @(((unsigned long (*)(id, SEL))imp)(plan, getter));
+    case 'Q':
+      return @(((unsigned long long (*)(id, SEL))imp)(plan, getter));
+    case 'f':
+      return @(((float (*)(id, SEL))imp)(plan, getter));
+    case 'd':
+      return @(((double (*)(id, SEL))imp)(plan, getter));
+    default:
+      // Structs and other less common types are boxed by key-value coding.
+      return [plan valueForKey:schema.name];
+  }
+}
 
+@implementation MDMConsoleLoggingTracer {
+  MDMConsoleLoggingTracerSink _sink;
+  NSMapTable<Class, NSArray<MDMPlanPropertySchema *> *> *_classToPropertySchemas;
+}
+
+- (instancetype)init {
+  return [self initWithSink:^(NSString * (^formatMessage)(void)) {
+    NSLog(@"%@", formatMessage());
+  }];
+}
+
+- (instancetype)initWithSink:(MDMConsoleLoggingTracerSink)sink {
+  self = [super init];
+  if (self) {
+    _sink = [sink copy];
+    _classToPropertySchemas =
+        [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsOpaqueMemory
+                                                | NSPointerFunctionsOpaquePersonality)
+                                  valueOptions:NSPointerFunctionsStrongMemory
+                                      capacity:0];
+  }
+  return self;
+}
+
+#pragma mark - Private
+
+- (NSString *)debugDescriptionOfPlanProperties:(NSObject<MDMPlan> *)plan {
+  Class planClass = [plan class];
+  NSArray<MDMPlanPropertySchema *> *schemas = [_classToPropertySchemas objectForKey:planClass];
+  if (!schemas) {
+    schemas = propertySchemasOfClass(planClass);
+    [_classToPropertySchemas setObject:schemas forKey:planClass];
+  }
+
+  NSMutableArray *propertyDescriptions = [NSMutableArray arrayWithCapacity:schemas.count];
+  for (MDMPlanPropertySchema *schema in schemas) {
+    [propertyDescriptions addObject:[NSString stringWithFormat:
+                                                  @"  %@: %@ = %@",
+                                                  schema.name,
+                                                  schema.typeName,
+                                                  valueOfProperty(plan, schema)]];
+  }
   return [propertyDescriptions componentsJoinedByString:@"\n"];
 }
 
-@implementation MDMConsoleLoggingTracer
+#pragma mark - MDMTracing
 
 - (void)didAddPlan:(NSObject<MDMPlan> *)plan to:(id)target {
-  NSLog(@"didAddPlan to target: %@\nPlan: %@\n%@\n\n",
-        target,
-        NSStringFromClass([plan class]),
-        debugDescriptionOfPlanProperties(plan));
+  _sink(^{
+    return [NSString stringWithFormat:@"didAddPlan to target: %@\nPlan: %@\n%@\n\n",
+                                      target,
+                                      NSStringFromClass([plan class]),
+                                      [self debugDescriptionOfPlanProperties:plan]];
+  });
 }
 
 - (void)didAddPlan:(id)plan named:(NSString *)name to:(id)target {
-  NSLog(@"didAddPlan named %@ to target: %@\nPlan: %@\n%@\n\n",
-        name,
-        target,
-        NSStringFromClass([plan class]),
-        debugDescriptionOfPlanProperties(plan));
+  _sink(^{
+    return [NSString stringWithFormat:@"didAddPlan named %@ to target: %@\nPlan: %@\n%@\n\n",
+                                      name,
+                                      target,
+                                      NSStringFromClass([plan class]),
+                                      [self debugDescriptionOfPlanProperties:plan]];
+  });
 }
 
 - (void)didRemovePlanNamed:(NSString *)name from:(id)target {
-  NSLog(@"didRemovePlan named %@ from target: %@\n\n", name, target);
+  _sink(^{
+    return [NSString stringWithFormat:@"didRemovePlan named %@ from target: %@\n\n", name, target];
+  });
 }
 
 - (void)didCreatePerformer:(NSObject<MDMPerforming> *)performer for:(id)target {
-  NSLog(@"didCreatePerformer: %@ for: %@\n\n", NSStringFromClass([performer class]), target);
+  _sink(^{
+    return [NSString stringWithFormat:@"didCreatePerformer: %@ for: %@\n\n",
+                                      NSStringFromClass([performer class]),
+                                      target];
+  });
+}
+
+- (void)didDropEmittedPlan:(NSObject<MDMPlan> *)plan to:(id)target {
+  _sink(^{
+    return [NSString stringWithFormat:@"didDropEmittedPlan to target: %@\nPlan: %@\n\n",
+                                      target,
+                                      NSStringFromClass([plan class])];
+  });
 }
 
 @end
@@ -0,0 +1,64 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ A base class for plans whose state is expensive to copy and is rarely mutated after being added.
+
+ The plan's state lives in a storage object. Copies of the plan share one storage object until one
+ of them requests mutableStorage, at which point that plan clones the storage and stops sharing it.
+ Copying a copy-on-write plan therefore allocates one small object regardless of the size of its
+ state.
+
+ Storage is cloned with mutableCopy if it conforms to NSMutableCopying, and with copy otherwise. The
+ clone must be independent of the original.
+
+ Plans that share storage may be copied and read on different threads. mutableStorage is not
+ synchronized, however: a plan must not be mutated while it, or any plan sharing its storage, is
+ being copied or mutated on another thread. Mutate plans on a single thread, typically before
+ handing them to the runtime.
+
+ Subclasses conform to MDMPlan themselves. Subclasses that declare state outside of the storage
+ object must override copyWithZone: and copy that state.
+ */
+NS_SWIFT_NAME(CopyOnWritePlan)
+@interface MDMCopyOnWritePlan : NSObject <NSCopying>
+
+/** Initializes a plan that is the sole owner of the given storage. */
+- (nonnull instancetype)initWithStorage:(nonnull id<NSCopying>)storage NS_DESIGNATED_INITIALIZER;
+
+/** Initializes a plan that shares the storage of the given plan. */
+- (nonnull instancetype)initSharingStorageOfPlan:(nonnull MDMCopyOnWritePlan *)plan
+    NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/** The storage object. Must not be mutated; use mutableStorage instead. */
+@property(nonatomic, strong, nonnull, readonly) id storage;
+
+/**
+ Returns a storage object that is owned by the receiver alone, cloning it if it is shared.
+
+ Not thread-safe. See the class discussion.
+ */
+- (nonnull id)mutableStorage;
+
+/** Whether the receiver's storage is currently shared with another plan. */
+@property(nonatomic, assign, readonly, getter=isStorageShared) BOOL storageShared;
+
+@end
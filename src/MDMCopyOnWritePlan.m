@@ -0,0 +1,89 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMCopyOnWritePlan.h"
+
+#import <stdatomic.h>
+
+// Counts the plans that share a storage object. Plans may be copied and released on any thread, so
+// the count is atomic. The check-and-clone in mutableStorage is not, which is why mutation is
+// restricted to a single thread.
+@interface MDMCopyOnWriteStorageBox : NSObject {
+ @package
+  id _storage;
+  _Atomic(NSUInteger) _ownerCount;
+}
+@end
+
+@implementation MDMCopyOnWriteStorageBox
+@end
+
+static MDMCopyOnWriteStorageBox *newStorageBox(id storage) {
+  MDMCopyOnWriteStorageBox *box = [MDMCopyOnWriteStorageBox new];
+  box->_storage = storage;
+  atomic_init(&box->_ownerCount, 1);
+  return box;
+}
+
+@implementation MDMCopyOnWritePlan {
+  MDMCopyOnWriteStorageBox *_box;
+}
+
+- (instancetype)initWithStorage:(id<NSCopying>)storage {
+  self = [super init];
+  if (self) {
+    _box = newStorageBox(storage);
+  }
+  return self;
+}
+
+- (instancetype)initSharingStorageOfPlan:(MDMCopyOnWritePlan *)plan {
+  self = [super init];
+  if (self) {
+    _box = plan->_box;
+    atomic_fetch_add_explicit(&_box->_ownerCount, 1, memory_order_relaxed);
+  }
+  return self;
+}
+
+- (void)dealloc {
+  atomic_fetch_sub_explicit(&_box->_ownerCount, 1, memory_order_acq_rel);
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return [[[self class] allocWithZone:zone] initSharingStorageOfPlan:self];
+}
+
+- (id)storage {
+  return _box->_storage;
+}
+
+- (BOOL)isStorageShared {
+  return atomic_load_explicit(&_box->_ownerCount, memory_order_acquire) > 1;
+}
+
+- (id)mutableStorage {
+  if (self.isStorageShared) {
+    id storage = _box->_storage;
+    id clone = [storage conformsToProtocol:@protocol(NSMutableCopying)] ? [storage mutableCopy]
+                                                                        : [storage copy];
+    atomic_fetch_sub_explicit(&_box->_ownerCount, 1, memory_order_acq_rel);
+    _box = newStorageBox(clone);
+  }
+  return _box->_storage;
+}
+
+@end
@@ -0,0 +1,36 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMClock.h"
+
+/**
+ A clock that reads the system's monotonic time and ticks when told to.
+
+ The current time is the time since an arbitrary point, such as system boot, and is unaffected by
+ changes to the wall clock. On Apple platforms it is in the same timebase as CACurrentMediaTime().
+
+ The clock does not tick by itself. Invoke tick from the host's frame callback, such as a display
+ link, to inform observers.
+ */
+NS_SWIFT_NAME(MonotonicClock)
+@interface MDMMonotonicClock : NSObject <MDMClock>
+
+/** Informs every observer that the clock has ticked. */
+- (void)tick;
+
+@end
@@ -0,0 +1,54 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMMonotonicClock.h"
+
+#import "private/MDMMonotonicTime.h"
+
+@implementation MDMMonotonicClock {
+  NSHashTable<id<MDMClockObserving>> *_observers;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _observers = [NSHashTable weakObjectsHashTable];
+  }
+  return self;
+}
+
+- (void)tick {
+  // Observers may add or remove observers in response to a tick.
+  for (id<MDMClockObserving> observer in _observers.allObjects) {
+    [observer clockDidTick:self];
+  }
+}
+
+#pragma mark - MDMClock
+
+- (NSTimeInterval)currentTime {
+  return (NSTimeInterval)MDMMonotonicTimeNanoseconds() / 1e9;
+}
+
+- (void)addClockObserver:(id<MDMClockObserving>)observer {
+  [_observers addObject:observer];
+}
+
+- (void)removeClockObserver:(id<MDMClockObserving>)observer {
+  [_observers removeObject:observer];
+}
+
+@end
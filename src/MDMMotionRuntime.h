@@ -16,11 +16,39 @@
 
 #import <Foundation/Foundation.h>
 
+#import "MDMRuntimeSnapshot.h"
+
+@class MDMPerformerLatencyRecorder;
+@class MDMPlanName;
+@class MDMTimeline;
+@protocol MDMClock;
 @protocol MDMMotionRuntimeDelegate;
 @protocol MDMPlan;
 @protocol MDMNamedPlan;
 @protocol MDMTracing;
 
+/** Determines when a runtime informs its delegate of activity state changes. */
+typedef NS_ENUM(NSInteger, MDMActivityNotificationCoalescing) {
+  /** The delegate is informed synchronously on every change of the activity state. */
+  MDMActivityNotificationCoalescingNone,
+
+  /**
+   The delegate is informed at most once per turn of the run loop of the thread that created the
+   runtime, and only if the activity state differs from the last state the delegate was informed
+   of.
+   */
+  MDMActivityNotificationCoalescingRunLoop,
+
+  /**
+   The delegate is informed at most once per tick of the runtime's activityNotificationClock, and
+   only if the activity state differs from the last state the delegate was informed of.
+
+   Behaves like MDMActivityNotificationCoalescingRunLoop while the runtime has no
+   activityNotificationClock.
+   */
+  MDMActivityNotificationCoalescingClock,
+} NS_SWIFT_NAME(ActivityNotificationCoalescing);
+
 /**
  An instance of MDMMotionRuntime acts as the mediating agent between plans and performers.
 
@@ -38,6 +66,11 @@
  The runtime creates performer instances when plans are added. Performers are expected to fulfill
  the provided plans.
 
+ ## Threading
+
+ A runtime is owned by the thread that created it. All methods must be invoked on the owning thread
+ except for the enqueue methods, which may be invoked from any thread.
+
  ## Lifecycle
 
  When an instance of a runtime is deallocated its performers will also be deallocated.
@@ -47,11 +80,22 @@ NS_SWIFT_NAME(MotionRuntime)
 
 #pragma mark Adding plans
 
-/** Associate a plan with a given target. */
+/**
+ Associate a plan with a given target.
+
+ The plan is copied unless it conforms to MDMImmutablePlan, in which case it is retained.
+ */
 - (void)addPlan:(nonnull NSObject<MDMPlan> *)plan to:(nonnull id)target
     NS_SWIFT_NAME(addPlan(_:to:));
 
-/** Associate plans with a given target. */
+/**
+ Associate plans with a given target.
+
+ The target's performers are looked up once for the entire batch. Plans are grouped by performer
+ class and each performer receives its plans in a single addPlans: invocation if it implements
+ one. The relative order of plans is preserved for each performer. MDMReplayablePlan instances are
+ added individually, between the batches of the plans that precede and follow them.
+ */
 - (void)addPlans:(nonnull NSArray<NSObject<MDMPlan> *> *)plans to:(nonnull id)target
     NS_SWIFT_NAME(addPlans(_:to:));
 
@@ -67,6 +111,20 @@ NS_SWIFT_NAME(MotionRuntime)
              to:(nonnull id)target
     NS_SWIFT_NAME(addPlan(_:named:to:));
 
+/**
+ Associates a named plan with a given target using an interned plan name.
+
+ Equivalent to addPlan:named:to: but never hashes the name's string.
+
+ @param plan The plan to add.
+ @param name Interned identifier for the plan.
+ @param target The target on which the plan can operate.
+ */
+- (void)addPlan:(nonnull id<MDMNamedPlan>)plan
+       withName:(nonnull MDMPlanName *)name
+             to:(nonnull id)target
+    NS_SWIFT_NAME(addPlan(_:named:to:));
+
 /**
  Removes any plan associated with the given name on the given target.
 
@@ -77,6 +135,160 @@ NS_SWIFT_NAME(MotionRuntime)
                    from:(nonnull id)target
     NS_SWIFT_NAME(removePlan(named:from:));
 
+/**
+ Removes any plan associated with the given interned name on the given target.
+
+ Equivalent to removePlanNamed:from: but never hashes the name's string.
+
+ @param name Interned identifier for the plan.
+ @param target The target on which the plan can operate.
+ */
+- (void)removePlanWithName:(nonnull MDMPlanName *)name
+                      from:(nonnull id)target
+    NS_SWIFT_NAME(removePlan(named:from:));
+
+#pragma mark Transactions
+
+/**
+ Begins buffering named plan mutations.
+
+ While a transaction is open, addPlan:named:to:, addPlan:withName:to:, removePlanNamed:from: and
+ removePlanWithName:from: only record the latest requested state of each (target, name) pair.
+ Unnamed plans are still added immediately.
+
+ Transactions may be nested. Only the outermost commitTransaction applies the buffered changes.
+ */
+- (void)beginTransaction;
+
+/**
+ Closes the innermost open transaction.
+
+ Closing the outermost transaction applies one net change per touched (target, name) pair, in the
+ order in which the pairs were first touched. A name whose final state is a plan is added, replacing
+ any existing plan of that name. A name whose final state is a removal is removed if present.
+ Performers and tracers never observe the intermediate states.
+ */
+- (void)commitTransaction;
+
+#pragma mark Submitting plans from any thread
+
+/**
+ Enqueues a plan to be associated with a given target. Safe to call from any thread.
+
+ The plan is copied on the calling thread. Enqueued commands are executed on the runtime's owning
+ thread, in order, the next time the owning thread's run loop runs in a common mode or when
+ drainEnqueuedPlans is invoked. Commands enqueued by one thread are always executed in the order
+ in which that thread enqueued them.
+ */
+- (void)enqueuePlan:(nonnull NSObject<MDMPlan> *)plan to:(nonnull id)target
+    NS_SWIFT_NAME(enqueuePlan(_:to:));
+
+/**
+ Enqueues a named plan to be associated with a given target. Safe to call from any thread.
+
+ Follows the same ordering and copying rules as enqueuePlan:to:.
+ */
+- (void)enqueuePlan:(nonnull id<MDMNamedPlan>)plan
+              named:(nonnull NSString *)name
+                 to:(nonnull id)target
+    NS_SWIFT_NAME(enqueuePlan(_:named:to:));
+
+/**
+ Enqueues the removal of any plan associated with the given name on the given target. Safe to call
+ from any thread.
+
+ Follows the same ordering rules as enqueuePlan:to:.
+ */
+- (void)enqueueRemovePlanNamed:(nonnull NSString *)name
+                          from:(nonnull id)target
+    NS_SWIFT_NAME(enqueueRemovePlan(named:from:));
+
+/**
+ Executes every enqueued command whose enqueue has completed.
+
+ Must be invoked on the runtime's owning thread.
+ */
+- (void)drainEnqueuedPlans;
+
+#pragma mark Plan emission
+
+/**
+ The maximum number of generations of emitted plans added by one outermost plan addition.
+
+ Plans emitted by composable performers are not added while the emitting performer is executing.
+ They are queued and added in generations after the outermost plan addition completes: plans
+ emitted by the performers of directly added plans form the first generation, plans emitted while
+ adding the first generation form the second, and so on. Emitted plans for the same target are
+ added as a batch.
+
+ Plans emitted beyond this depth are dropped and reported to tracers with didDropEmittedPlan:to:.
+ Exceeding the depth usually indicates an emission cycle. Defaults to 32.
+ */
+@property(nonatomic, assign) NSUInteger maximumPlanEmissionDepth;
+
+/**
+ The maximum number of emitted plans added by one outermost plan addition.
+
+ Plans emitted beyond this count are dropped and reported to tracers with didDropEmittedPlan:to:.
+ Defaults to 4096.
+ */
+@property(nonatomic, assign) NSUInteger maximumEmittedPlanCount;
+
+/** The number of emitted plans that have been dropped for exceeding an emission limit. */
+@property(nonatomic, assign, readonly) NSUInteger droppedEmittedPlanCount;
+
+#pragma mark Plan deduplication
+
+/**
+ Whether additions of MDMEquatablePlan plans equal to a plan already added to the same target are
+ skipped. Disabled by default.
+
+ A skipped plan is neither copied, tokenized nor given to a performer. Only plans added while
+ deduplication is enabled are remembered.
+ */
+@property(nonatomic, assign) BOOL deduplicatesEquatablePlans;
+
+/** The number of equatable plan additions that were checked for an equal plan. */
+@property(nonatomic, assign, readonly) NSUInteger planDeduplicationLookupCount;
+
+/** The number of equatable plan additions that were skipped. */
+@property(nonatomic, assign, readonly) NSUInteger deduplicatedPlanCount;
+
+#pragma mark Plan templates
+
+/**
+ Discards the recorded templates of every MDMReplayablePlan of the given class.
+
+ The next addition of each such plan runs its performer and records a new template.
+ */
+- (void)invalidatePlanTemplatesForPlanClass:(nonnull Class)planClass
+    NS_SWIFT_NAME(invalidatePlanTemplates(for:));
+
+/** Discards every recorded MDMReplayablePlan template. */
+- (void)invalidateAllPlanTemplates;
+
+/**
+ The number of replayable plan additions that were satisfied by a recorded template.
+
+ Replayed plans are not tokenized: an addition satisfied by a template doesn't create the plan's
+ performer, so no token is generated for the plan. The plans queued from the template are tokenized
+ like any other plan.
+ */
+@property(nonatomic, assign, readonly) NSUInteger replayedPlanTemplateCount;
+
+#pragma mark Timelines
+
+/**
+ Adds a timeline whose sampled curves are resampled when the plans of their targets change.
+
+ The timeline is informed of every plan change synchronously. It is strongly held by the runtime and
+ is not a tracer.
+ */
+- (void)addTimeline:(nonnull MDMTimeline *)timeline NS_SWIFT_NAME(addTimeline(_:));
+
+/** Removes a timeline. Does nothing if the timeline was not added to the runtime. */
+- (void)removeTimeline:(nonnull MDMTimeline *)timeline NS_SWIFT_NAME(removeTimeline(_:));
+
 #pragma mark Tracing
 
 /**
@@ -98,6 +310,43 @@ NS_SWIFT_NAME(MotionRuntime)
 /** Returns the list of registered tracers. */
 - (nonnull NSArray<id<MDMTracing>> *)tracers;
 
+/**
+ Whether tracer events are delivered on a background thread. Disabled by default.
+
+ When enabled, each event is written as a fixed-size record into a lock-free ring buffer and the
+ tracers are invoked on a dedicated background thread in the order in which the events occurred.
+ The objects referenced by an event are retained until the event has been delivered and are always
+ released on the runtime's thread.
+
+ Tracer methods are then invoked off the runtime's thread. They must not read or modify the UI state
+ of the targets, plans or performers they are handed, e.g. a UIView's frame or a CALayer's
+ properties; UIKit objects may only be used on the main thread.
+
+ If the ring buffer is full the event is dropped and droppedTraceEventCount is incremented.
+
+ Disabling asynchronous tracing delivers all outstanding events before returning.
+ */
+@property(nonatomic, assign, getter=isAsynchronousTracingEnabled) BOOL asynchronousTracingEnabled;
+
+/** The number of tracer events dropped because the asynchronous tracing buffer was full. */
+@property(nonatomic, assign, readonly) NSUInteger droppedTraceEventCount;
+
+/**
+ Blocks until every tracer event generated so far has been delivered.
+
+ Does nothing if asynchronous tracing is disabled.
+ */
+- (void)flushTracers;
+
+/**
+ Times every performer callback when non-nil. nil by default.
+
+ initWithTarget:, addPlan:, addPlans:, addPlan:named:, removePlanNamed: and
+ replacePlanNamed:withPlan: invocations are timed. When no recorder is set, callbacks are invoked
+ without reading the clock.
+ */
+@property(nonatomic, strong, nullable) MDMPerformerLatencyRecorder *performerLatencyRecorder;
+
 #pragma mark State
 
 /**
@@ -107,11 +356,87 @@ NS_SWIFT_NAME(MotionRuntime)
  */
 @property(nonatomic, assign, readonly, getter=isActive) BOOL active;
 
+/**
+ Returns the number of active tokens for plans that were added to the given target.
+
+ Returns 0 for targets that have never had plans added to them.
+ */
+- (NSUInteger)activeTokenCountForTarget:(nonnull id)target
+    NS_SWIFT_NAME(activeTokenCount(for:));
+
+#pragma mark Performer eviction
+
+/**
+ The maximum number of performers the runtime keeps alive. 0, the default, means unlimited.
+
+ When the number of performers exceeds the budget, the runtime evicts idle performers, least
+ recently idle first. A performer is idle when none of its tokens are active and it holds no named
+ plans. Performers that have received unnamed plans are only evicted if they conform to
+ MDMRehydratablePerforming and received every unnamed plan while a budget was set, since the runtime
+ only retains plans for rehydration while a budget is set. The budget may be exceeded when not
+ enough performers are idle.
+ */
+@property(nonatomic, assign) NSUInteger performerBudget;
+
+/** The number of performers that have been evicted. */
+@property(nonatomic, assign, readonly) NSUInteger performerEvictionCount;
+
+/** The number of performers that have been recreated after being evicted. */
+@property(nonatomic, assign, readonly) NSUInteger performerRehydrationCount;
+
+#pragma mark Frame scheduling
+
+/**
+ The clock whose ticks step the steppers scheduled by MDMFrameScheduledPerforming performers and
+ the runtime's MDMSpring and MDMTween plans.
+
+ Every scheduled stepper is stepped once per tick in a single loop, grouped by stepper class. All of
+ the runtime's springs and tweens are integrated together as one stepper. Scheduled steppers are
+ not stepped while the clock is nil, the default. Use an MDMVirtualClock to
+ drive performers without a display.
+ */
+@property(nonatomic, strong, nullable) id<MDMClock> frameClock;
+
+/** The number of steppers that are currently scheduled with the runtime's frame scheduler. */
+@property(nonatomic, assign, readonly) NSUInteger scheduledStepperCount;
+
+#pragma mark Introspection
+
+/**
+ Returns a summary of the objects currently held by the runtime.
+
+ Equivalent to snapshotWithOptions:MDMRuntimeSnapshotOptionNone. The cost is proportional to the
+ number of targets and performers, which makes it suitable for periodic polling.
+ */
+- (nonnull MDMRuntimeSnapshot *)snapshot;
+
+/** Returns a summary of the objects currently held by the runtime with the requested detail. */
+- (nonnull MDMRuntimeSnapshot *)snapshotWithOptions:(MDMRuntimeSnapshotOptions)options
+    NS_SWIFT_NAME(snapshot(options:));
+
 #pragma mark Delegated events
 
 /** A runtime delegate can listen to specific state change events. */
 @property(nonatomic, weak, nullable) id<MDMMotionRuntimeDelegate> delegate;
 
+/**
+ Determines when the delegate is informed of activity state changes.
+
+ Defaults to MDMActivityNotificationCoalescingNone. The coalescing modes protect the delegate from
+ performers that rapidly toggle their tokens.
+ */
+@property(nonatomic, assign) MDMActivityNotificationCoalescing activityNotificationCoalescing;
+
+/**
+ The clock whose ticks deliver coalesced activity notifications when activityNotificationCoalescing
+ is MDMActivityNotificationCoalescingClock.
+
+ While this is nil, clock coalescing falls back to run loop coalescing so that no activity state
+ change is lost. A change still waiting for a tick when the clock is cleared is delivered on the
+ next turn of the run loop.
+ */
+@property(nonatomic, strong, nullable) id<MDMClock> activityNotificationClock;
+
 @end
 
 /**
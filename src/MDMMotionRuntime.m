@@ -16,41 +16,355 @@
 
 #import "MDMMotionRuntime.h"
 
+#import "MDMClock.h"
+#import "MDMPlanName.h"
+#import "MDMTimeline.h"
 #import "MDMTracing.h"
+#import "private/MDMFrameScheduler.h"
+#import "private/MDMMotionRuntime+Private.h"
+#import "private/MDMNamedPlanTransaction.h"
+#import "private/MDMPerformerBudget.h"
+#import "private/MDMPlanCommandQueue.h"
+#import "private/MDMPlanCopying.h"
+#import "private/MDMPlanName+Private.h"
+#import "private/MDMPlanEmissionQueue.h"
+#import "private/MDMPlanTemplateCache.h"
+#import "private/MDMRuntimeSnapshot+Private.h"
 #import "private/MDMTargetRegistry.h"
 #import "private/MDMTargetScope.h"
 #import "private/MDMToken.h"
 #import "private/MDMTokenPool.h"
+#import "private/MDMTracerTable.h"
 
-@interface MDMMotionRuntime () <MDMTokenActivityObserving>
-
-@property(nonatomic, strong, readonly) NSMutableSet<id<MDMTokened>> *activeTokens;
-
+@interface MDMMotionRuntime () <MDMClockObserving, MDMPlanCommandExecuting, MDMTokenActivityObserving>
 @end
 
 @implementation MDMMotionRuntime {
   MDMTargetRegistry *_targetRegistry;
-  NSMutableOrderedSet<id<MDMTracing>> *_tracers;
+  MDMTracerTable *_tracers;
+
+  NSThread *_owningThread;
+  MDMPlanCommandQueue *_commandQueue;
+
+  NSUInteger _transactionDepth;
+  MDMNamedPlanTransaction *_transaction;
+
+  // The number of plan additions and removals in progress on the stack.
+  NSUInteger _mutationDepth;
+  MDMPlanEmissionQueue *_emissionQueue;
+  // The generation of emitted plans being added. 0 outside of emission draining.
+  NSUInteger _emissionGeneration;
+  // The number of plans emitted since the emission queue was last empty.
+  NSUInteger _emittedPlanCount;
+  BOOL _isDrainingEmittedPlans;
+
+  MDMPlanTemplateCache *_templateCache;
+  // Non-nil while the performer of a replayable plan without a template is being given the plan.
+  // Reset to nil if the emissions can't be replayed.
+  NSMutableArray<NSObject<MDMPlan> *> *_templateRecording;
+  id _templateRecordingTarget;
+
+  NSUInteger _activeTokenCount;
+  NSUInteger _peakActiveTokenCount;
+
+  // The activity state the delegate was last informed of.
+  BOOL _lastNotifiedActive;
+  BOOL _hasScheduledRunLoopNotification;
 }
 
 - (instancetype)init {
   self = [super init];
   if (self) {
-    _tracers = [NSMutableOrderedSet orderedSet];
+    _tracers = [MDMTracerTable new];
     _targetRegistry = [[MDMTargetRegistry alloc] initWithRuntime:self tracers:_tracers];
-    _activeTokens = [NSMutableSet set];
+    _owningThread = [NSThread currentThread];
+    _commandQueue = [MDMPlanCommandQueue new];
+    _emissionQueue = [MDMPlanEmissionQueue new];
+    _templateCache = [MDMPlanTemplateCache new];
+    _maximumPlanEmissionDepth = 32;
+    _maximumEmittedPlanCount = 4096;
   }
   return self;
 }
 
+- (void)dealloc {
+  [_activityNotificationClock removeClockObserver:self];
+
+  // Deliver any outstanding events while the runtime's internals are still alive.
+  _tracers.asynchronous = NO;
+}
+
 #pragma mark - Private
 
-- (void)willAddPlan:(NSObject<MDMPlan> *)plan {
-  MDMToken *token = (MDMToken *)[_targetRegistry.tokenPool tokenForPlan:plan];
-  [token addActivityObserver:self];
+- (void)willAddPlan:(NSObject<MDMPlan> *)plan toScope:(MDMTargetScope *)scope {
+  MDMToken *token = (MDMToken *)[scope.tokenPool tokenForPlan:plan];
+  [token setActivityObserver:self targetScope:scope];
+}
+
+- (void)addCopiedPlan:(NSObject<MDMPlan> *)copiedPlan to:(id)target {
+  if ([copiedPlan conformsToProtocol:@protocol(MDMReplayablePlan)]) {
+    [self addCopiedReplayablePlan:(NSObject<MDMReplayablePlan> *)copiedPlan to:target];
+    return;
+  }
+  [self beginMutation];
+  MDMTargetScope *scope = [_targetRegistry scopeForTarget:target];
+  [self willAddPlan:copiedPlan toScope:scope];
+  [scope addPlan:copiedPlan to:target];
+  [self rememberPlan:copiedPlan inScope:scope];
+  [self endMutation];
+}
+
+- (void)addCopiedPlans:(NSArray<NSObject<MDMPlan> *> *)copiedPlans to:(id)target {
+  [self beginMutation];
+  // Replayable plans may be replayed from their templates, so they don't take part in a batch. The
+  // plans between them are added as batches, preserving the order of all plans.
+  NSUInteger count = copiedPlans.count;
+  NSUInteger runStart = 0;
+  for (NSUInteger index = 0; index <= count; index++) {
+    BOOL isReplayable = index < count
+        && [copiedPlans[index] conformsToProtocol:@protocol(MDMReplayablePlan)];
+    if (index < count && !isReplayable) {
+      continue;
+    }
+    if (index > runStart) {
+      NSRange run = NSMakeRange(runStart, index - runStart);
+      [self addCopiedPlanBatch:(run.length == count ? copiedPlans
+                                                    : [copiedPlans subarrayWithRange:run])
+                            to:target];
+    }
+    if (isReplayable) {
+      [self addCopiedReplayablePlan:(NSObject<MDMReplayablePlan> *)copiedPlans[index] to:target];
+    }
+    runStart = index + 1;
+  }
+  [self endMutation];
+}
+
+// Adds plans none of which are replayable.
+- (void)addCopiedPlanBatch:(NSArray<NSObject<MDMPlan> *> *)copiedPlans to:(id)target {
+  MDMTargetScope *scope = [_targetRegistry scopeForTarget:target];
+  for (NSObject<MDMPlan> *copiedPlan in copiedPlans) {
+    [self willAddPlan:copiedPlan toScope:scope];
+  }
+  [scope addPlans:copiedPlans to:target];
+  for (NSObject<MDMPlan> *copiedPlan in copiedPlans) {
+    [self rememberPlan:copiedPlan inScope:scope];
+  }
+}
+
+- (void)addCopiedReplayablePlan:(NSObject<MDMReplayablePlan> *)copiedPlan to:(id)target {
+  [self beginMutation];
+  NSArray<NSObject<MDMPlan> *> *template = [_templateCache templateForPlan:copiedPlan];
+  if (template) {
+    // Queue the recorded plans as though the plan's performer had emitted them. The plan's
+    // performer isn't created, so the plan itself receives no token.
+    _replayedPlanTemplateCount++;
+    [self rememberPlan:copiedPlan forTarget:target];
+    for (NSObject<MDMPlan> *templatePlan in template) {
+      if (![self isRedundantPlan:templatePlan forTarget:target]) {
+        NSObject<MDMPlan> *copiedTemplatePlan = MDMRetainedCopyOfPlan(templatePlan);
+        [self rememberPlan:copiedTemplatePlan forTarget:target];
+        [_emissionQueue enqueuePlan:copiedTemplatePlan to:target];
+      }
+    }
+    [_tracers didAddPlan:copiedPlan to:target];
+    [self endMutation];
+    return;
+  }
+
+  NSMutableArray<NSObject<MDMPlan> *> *outerRecording = _templateRecording;
+  id outerRecordingTarget = _templateRecordingTarget;
+  NSMutableArray<NSObject<MDMPlan> *> *recording = [NSMutableArray array];
+  _templateRecording = recording;
+  _templateRecordingTarget = target;
+
+  MDMTargetScope *scope = [_targetRegistry scopeForTarget:target];
+  [self willAddPlan:copiedPlan toScope:scope];
+  [scope addPlan:copiedPlan to:target];
+  [self rememberPlan:copiedPlan inScope:scope];
+
+  if (_templateRecording == recording) {
+    [_templateCache setTemplate:recording forPlan:copiedPlan];
+  }
+  _templateRecording = outerRecording;
+  _templateRecordingTarget = outerRecordingTarget;
+  [self endMutation];
+}
+
+// Returns YES if the plan should be skipped because an equal plan was already added to the target.
+- (BOOL)isRedundantPlan:(NSObject<MDMPlan> *)plan forTarget:(id)target {
+  if (!_deduplicatesEquatablePlans || ![plan conformsToProtocol:@protocol(MDMEquatablePlan)]) {
+    return NO;
+  }
+  _planDeduplicationLookupCount++;
+  MDMTargetScope *scope = [_targetRegistry existingScopeForTarget:target];
+  if (![scope touchEquatablePlan:(NSObject<MDMEquatablePlan> *)plan]) {
+    return NO;
+  }
+  _deduplicatedPlanCount++;
+  return YES;
+}
+
+- (void)rememberPlan:(NSObject<MDMPlan> *)copiedPlan inScope:(MDMTargetScope *)scope {
+  if (_deduplicatesEquatablePlans && [copiedPlan conformsToProtocol:@protocol(MDMEquatablePlan)]) {
+    [scope rememberEquatablePlan:(NSObject<MDMEquatablePlan> *)copiedPlan];
+  }
+}
+
+// Remembers a plan that has not reached its target's scope yet, such as a plan that is queued, so
+// that an equal plan added before the queue drains is recognized as redundant.
+- (void)rememberPlan:(NSObject<MDMPlan> *)copiedPlan forTarget:(id)target {
+  if (_deduplicatesEquatablePlans && [copiedPlan conformsToProtocol:@protocol(MDMEquatablePlan)]) {
+    MDMTargetScope *scope = [_targetRegistry scopeForTarget:target];
+    [scope rememberEquatablePlan:(NSObject<MDMEquatablePlan> *)copiedPlan];
+  }
+}
+
+- (void)recordEmittedPlan:(NSObject<MDMPlan> *)copiedPlan to:(id)target {
+  if (target != _templateRecordingTarget) {
+    _templateRecording = nil;
+    return;
+  }
+  NSArray<NSObject<MDMPlan> *> *template = nil;
+  if ([copiedPlan conformsToProtocol:@protocol(MDMReplayablePlan)]) {
+    template = [_templateCache templateForPlan:(NSObject<MDMReplayablePlan> *)copiedPlan];
+  }
+  if (template) {
+    [_templateRecording addObjectsFromArray:template];
+  } else {
+    [_templateRecording addObject:copiedPlan];
+  }
+}
+
+- (void)addCopiedPlan:(NSObject<MDMNamedPlan> *)copiedPlan
+                named:(MDMPlanName *)name
+                   to:(id)target {
+  if (_transactionDepth > 0) {
+    [_transaction setPlan:copiedPlan named:name forTarget:target];
+    return;
+  }
+  [self beginMutation];
+  MDMTargetScope *scope = [_targetRegistry scopeForTarget:target];
+  [self willAddPlan:(NSObject<MDMPlan> *)copiedPlan toScope:scope];
+  [scope addPlan:copiedPlan named:name to:target];
+  [self endMutation];
+}
+
+- (void)beginMutation {
+  _mutationDepth++;
+}
+
+// Adds the plans emitted during the mutation once the outermost mutation completes.
+- (void)endMutation {
+  _mutationDepth--;
+  if (_mutationDepth == 0) {
+    [self drainEmittedPlans];
+  }
+}
+
+- (void)drainEmittedPlans {
+  // Plans emitted while draining are added by the drain loop itself.
+  if (_isDrainingEmittedPlans) {
+    return;
+  }
+  _isDrainingEmittedPlans = YES;
+  while (!_emissionQueue.isEmpty) {
+    _emissionGeneration++;
+    [_emissionQueue drainGenerationUsingBlock:^(id target, NSArray<NSObject<MDMPlan> *> *plans) {
+      if (plans.count == 1) {
+        [self addCopiedPlan:plans.firstObject to:target];
+      } else {
+        [self addCopiedPlans:plans to:target];
+      }
+    }];
+  }
+  _emissionGeneration = 0;
+  _emittedPlanCount = 0;
+  _isDrainingEmittedPlans = NO;
+}
+
+- (void)emitPlan:(NSObject<MDMPlan> *)plan to:(id)target {
+  if (_emissionGeneration >= _maximumPlanEmissionDepth
+      || _emittedPlanCount >= _maximumEmittedPlanCount) {
+    _droppedEmittedPlanCount++;
+    // A template must not capture an expansion that was cut short.
+    _templateRecording = nil;
+    [_tracers didDropEmittedPlan:plan to:target];
+    return;
+  }
+  NSObject<MDMPlan> *copiedPlan = MDMRetainedCopyOfPlan(plan);
+  // Redundant plans are still recorded, since a template may be replayed to other targets.
+  if (_templateRecording) {
+    [self recordEmittedPlan:copiedPlan to:target];
+  }
+  if ([self isRedundantPlan:plan forTarget:target]) {
+    return;
+  }
+  _emittedPlanCount++;
+  [self rememberPlan:copiedPlan forTarget:target];
+  [_emissionQueue enqueuePlan:copiedPlan to:target];
+
+  // Plans emitted outside of a plan addition, e.g. from a gesture callback, are added immediately.
+  if (_mutationDepth == 0) {
+    [self drainEmittedPlans];
+  }
+}
+
+- (void)enqueueCommandOfType:(MDMPlanCommandType)type
+                        plan:(id)plan
+                      target:(id)target
+                        name:(MDMPlanName *)name {
+  if ([_commandQueue enqueueCommandOfType:type plan:plan target:target name:name]) {
+    [self performSelector:@selector(drainEnqueuedPlans)
+                 onThread:_owningThread
+               withObject:nil
+            waitUntilDone:NO
+                    modes:@[ NSRunLoopCommonModes ]];
+  }
 }
 
 - (void)stateDidChange {
+  switch (_activityNotificationCoalescing) {
+    case MDMActivityNotificationCoalescingNone:
+      [self notifyDelegate];
+      break;
+
+    case MDMActivityNotificationCoalescingRunLoop:
+      [self scheduleRunLoopNotification];
+      break;
+
+    case MDMActivityNotificationCoalescingClock:
+      // Delivered on the next tick of the activity notification clock. Without a clock there are no
+      // ticks, so fall back to run loop coalescing.
+      if (!_activityNotificationClock) {
+        [self scheduleRunLoopNotification];
+      }
+      break;
+  }
+}
+
+- (void)scheduleRunLoopNotification {
+  if (_hasScheduledRunLoopNotification) {
+    return;
+  }
+  _hasScheduledRunLoopNotification = YES;
+  // Tokens may change state on other threads, whose run loops might never run again.
+  [self performSelector:@selector(deliverCoalescedNotification)
+               onThread:_owningThread
+             withObject:nil
+          waitUntilDone:NO
+                  modes:@[ NSRunLoopCommonModes ]];
+}
+
+- (void)deliverCoalescedNotification {
+  _hasScheduledRunLoopNotification = NO;
+  if (self.isActive != _lastNotifiedActive) {
+    [self notifyDelegate];
+  }
+}
+
+- (void)notifyDelegate {
+  _lastNotifiedActive = self.isActive;
   if ([self.delegate respondsToSelector:@selector(motionRuntimeActivityStateDidChange:)]) {
     [self.delegate motionRuntimeActivityStateDidChange:self];
   }
@@ -59,65 +373,326 @@
 #pragma mark - MDMTokenActivityObserving
 
 - (void)tokenDidActivate:(MDMToken *)token {
-  BOOL wasInactive = _activeTokens.count == 0;
+  [self tokenCount:1
+      didActivateInTargetScope:token.targetScope
+                 performerSlot:token->_performerSlot];
+}
+
+- (void)tokenDidDeactivate:(MDMToken *)token {
+  [self tokenCount:1
+      didDeactivateInTargetScope:token.targetScope
+                   performerSlot:token->_performerSlot];
+}
 
-  [_activeTokens addObject:token];
+- (void)tokenCount:(NSUInteger)count
+    didActivateInTargetScope:(MDMTargetScope *)scope
+               performerSlot:(NSUInteger)slot {
+  [scope didActivateTokenCount:count forPerformerSlot:slot];
 
+  BOOL wasInactive = _activeTokenCount == 0;
+  _activeTokenCount += count;
+  _peakActiveTokenCount = MAX(_peakActiveTokenCount, _activeTokenCount);
   if (wasInactive) {
     [self stateDidChange];
   }
 }
 
-- (void)tokenDidDeactivate:(MDMToken *)token {
-  NSAssert([_activeTokens containsObject:token],
+- (void)tokenCount:(NSUInteger)count
+    didDeactivateInTargetScope:(MDMTargetScope *)scope
+                 performerSlot:(NSUInteger)slot {
+  NSAssert(_activeTokenCount >= count,
            @"Token is not active. May have already been terminated by a previous invocation.");
 
-  [_activeTokens removeObject:token];
+  [scope didDeactivateTokenCount:count forPerformerSlot:slot];
 
-  if (_activeTokens.count == 0) {
+  _activeTokenCount -= count;
+  if (_activeTokenCount == 0) {
     [self stateDidChange];
   }
+
+  if (scope && scope.activeTokenCount == 0) {
+    [_targetRegistry reclaimScopeIfIdle:scope];
+  }
+}
+
+#pragma mark - MDMPlanCommandExecuting
+
+- (void)executePlanCommand:(const MDMPlanCommand *)command {
+  id target = (__bridge id)command->target;
+  switch (command->type) {
+    case MDMPlanCommandTypeAddPlan: {
+      NSObject<MDMPlan> *plan = (__bridge NSObject<MDMPlan> *)command->plan;
+      if (![self isRedundantPlan:plan forTarget:target]) {
+        [self addCopiedPlan:plan to:target];
+      }
+      break;
+    }
+
+    case MDMPlanCommandTypeAddPlanNamed:
+      [self addCopiedPlan:(__bridge NSObject<MDMNamedPlan> *)command->plan
+                    named:(__bridge MDMPlanName *)command->name
+                       to:target];
+      break;
+
+    case MDMPlanCommandTypeRemovePlanNamed:
+      [self removePlanWithName:(__bridge MDMPlanName *)command->name from:target];
+      break;
+  }
+}
+
+#pragma mark - MDMClockObserving
+
+- (void)clockDidTick:(id<MDMClock>)clock {
+  if (_activityNotificationCoalescing == MDMActivityNotificationCoalescingClock) {
+    [self deliverCoalescedNotification];
+  }
 }
 
 #pragma mark - Public
 
 - (BOOL)isActive {
-  return self.activeTokens.count > 0;
+  return _activeTokenCount > 0;
+}
+
+- (NSUInteger)performerBudget {
+  return _targetRegistry.performerBudget.maximumPerformerCount;
+}
+
+- (void)setPerformerBudget:(NSUInteger)performerBudget {
+  _targetRegistry.performerBudget.maximumPerformerCount = performerBudget;
+  [_targetRegistry.performerBudget evictIfNeeded];
+}
+
+- (NSUInteger)performerEvictionCount {
+  return _targetRegistry.performerBudget.evictionCount;
+}
+
+- (NSUInteger)performerRehydrationCount {
+  return _targetRegistry.performerBudget.rehydrationCount;
+}
+
+- (id<MDMClock>)frameClock {
+  return _targetRegistry.frameScheduler.clock;
+}
+
+- (void)setFrameClock:(id<MDMClock>)frameClock {
+  _targetRegistry.frameScheduler.clock = frameClock;
+}
+
+- (NSUInteger)scheduledStepperCount {
+  return _targetRegistry.frameScheduler.scheduledStepperCount;
+}
+
+- (NSUInteger)activeTokenCountForTarget:(id)target {
+  return [_targetRegistry existingScopeForTarget:target].activeTokenCount;
+}
+
+- (MDMRuntimeSnapshot *)snapshot {
+  return [self snapshotWithOptions:MDMRuntimeSnapshotOptionNone];
+}
+
+- (MDMRuntimeSnapshot *)snapshotWithOptions:(MDMRuntimeSnapshotOptions)options {
+  MDMRuntimeSnapshot *snapshot = [[MDMRuntimeSnapshot alloc] initInternal];
+  [_targetRegistry populateSnapshot:snapshot
+                   includingTargets:(options & MDMRuntimeSnapshotOptionTargetBreakdown) != 0];
+  snapshot.activeTokenCount = _activeTokenCount;
+  snapshot.peakActiveTokenCount = _peakActiveTokenCount;
+  snapshot.tracerCount = _tracers.tracers.count;
+  return snapshot;
+}
+
+- (void)setActivityNotificationCoalescing:(MDMActivityNotificationCoalescing)coalescing {
+  if (_activityNotificationCoalescing == coalescing) {
+    return;
+  }
+  _activityNotificationCoalescing = coalescing;
+  _lastNotifiedActive = self.isActive;
+}
+
+- (void)setActivityNotificationClock:(id<MDMClock>)clock {
+  if (_activityNotificationClock == clock) {
+    return;
+  }
+  [_activityNotificationClock removeClockObserver:self];
+  _activityNotificationClock = clock;
+  [_activityNotificationClock addClockObserver:self];
+
+  // A change that was waiting for the removed clock's next tick is delivered by the run loop.
+  if (!clock && _activityNotificationCoalescing == MDMActivityNotificationCoalescingClock
+      && self.isActive != _lastNotifiedActive) {
+    [self scheduleRunLoopNotification];
+  }
 }
 
 - (void)addPlan:(NSObject<MDMPlan> *)plan to:(id)target {
-  NSObject<MDMPlan> *copiedPlan = [plan copy];
-  [self willAddPlan:copiedPlan];
-  [_targetRegistry addPlan:copiedPlan to:target];
+  if ([self isRedundantPlan:plan forTarget:target]) {
+    return;
+  }
+  [self addCopiedPlan:MDMRetainedCopyOfPlan(plan) to:target];
 }
 
 - (void)addPlans:(nonnull NSArray<NSObject<MDMPlan> *> *)plans to:(nonnull id)target {
+  if (plans.count == 0) {
+    return;
+  }
+  NSMutableArray<NSObject<MDMPlan> *> *copiedPlans = [NSMutableArray arrayWithCapacity:plans.count];
   for (NSObject<MDMPlan> *plan in plans) {
-    [self addPlan:plan to:target];
+    if (![self isRedundantPlan:plan forTarget:target]) {
+      NSObject<MDMPlan> *copiedPlan = MDMRetainedCopyOfPlan(plan);
+      // Remember the plan right away so that an equal plan later in the batch is redundant.
+      [self rememberPlan:copiedPlan forTarget:target];
+      [copiedPlans addObject:copiedPlan];
+    }
+  }
+  if (copiedPlans.count > 0) {
+    [self addCopiedPlans:copiedPlans to:target];
   }
 }
 
 - (void)addPlan:(NSObject<MDMNamedPlan> *)plan named:(NSString *)name to:(id)target {
   NSParameterAssert(name.length > 0);
-  NSObject<MDMNamedPlan> *copiedPlan = [plan copy];
-  [self willAddPlan:(NSObject<MDMPlan> *)copiedPlan];
-  [_targetRegistry addPlan:copiedPlan named:name to:target];
+  [self addCopiedPlan:MDMRetainedCopyOfPlan(plan)
+                named:[MDMPlanName transientPlanNameWithString:name]
+                   to:target];
+}
+
+- (void)addPlan:(NSObject<MDMNamedPlan> *)plan withName:(MDMPlanName *)name to:(id)target {
+  [self addCopiedPlan:MDMRetainedCopyOfPlan(plan) named:name to:target];
 }
 
 - (void)removePlanNamed:(NSString *)name from:(id)target {
   NSParameterAssert(name.length > 0);
+  // Named plans retain their handle, so a name without a live handle names no plan.
+  MDMPlanName *planName = [MDMPlanName existingPlanNameWithString:name];
+  if (planName) {
+    [self removePlanWithName:planName from:target];
+  }
+}
+
+- (void)removePlanWithName:(MDMPlanName *)name from:(id)target {
+  if (_transactionDepth > 0) {
+    [_transaction setPlan:nil named:name forTarget:target];
+    return;
+  }
+  [self beginMutation];
   [_targetRegistry removePlanNamed:name from:target];
+  [self endMutation];
+}
+
+- (void)invalidatePlanTemplatesForPlanClass:(Class)planClass {
+  [_templateCache removeTemplatesForPlanClass:planClass];
+}
+
+- (void)invalidateAllPlanTemplates {
+  [_templateCache removeAllTemplates];
+}
+
+- (void)beginTransaction {
+  if (_transactionDepth == 0 && !_transaction) {
+    _transaction = [MDMNamedPlanTransaction new];
+  }
+  _transactionDepth++;
+}
+
+- (void)commitTransaction {
+  NSAssert(_transactionDepth > 0, @"commitTransaction invoked without a matching beginTransaction.");
+  if (_transactionDepth == 0) {
+    return;
+  }
+  _transactionDepth--;
+  if (_transactionDepth > 0) {
+    return;
+  }
+
+  [self beginMutation];
+  [_transaction drainUsingBlock:^(id target, MDMPlanName *name, id<MDMNamedPlan> plan) {
+    if (plan) {
+      [self addCopiedPlan:(NSObject<MDMNamedPlan> *)plan named:name to:target];
+    } else {
+      [self removePlanWithName:name from:target];
+    }
+  }];
+  [self endMutation];
+}
+
+- (void)enqueuePlan:(NSObject<MDMPlan> *)plan to:(id)target {
+  [self enqueueCommandOfType:MDMPlanCommandTypeAddPlan
+                        plan:MDMRetainedCopyOfPlan(plan)
+                      target:target
+                        name:nil];
+}
+
+- (void)enqueuePlan:(NSObject<MDMNamedPlan> *)plan named:(NSString *)name to:(id)target {
+  NSParameterAssert(name.length > 0);
+  [self enqueueCommandOfType:MDMPlanCommandTypeAddPlanNamed
+                        plan:MDMRetainedCopyOfPlan(plan)
+                      target:target
+                        name:[MDMPlanName transientPlanNameWithString:name]];
+}
+
+- (void)enqueueRemovePlanNamed:(NSString *)name from:(id)target {
+  NSParameterAssert(name.length > 0);
+  // Any earlier enqueued addition under this name retains its handle.
+  MDMPlanName *planName = [MDMPlanName existingPlanNameWithString:name];
+  if (!planName) {
+    return;
+  }
+  [self enqueueCommandOfType:MDMPlanCommandTypeRemovePlanNamed
+                        plan:nil
+                      target:target
+                        name:planName];
+}
+
+- (void)drainEnqueuedPlans {
+  NSAssert([NSThread currentThread] == _owningThread,
+           @"Enqueued plans must be drained on the runtime's owning thread.");
+  [self beginMutation];
+  [_commandQueue drainToExecutor:self];
+  [self endMutation];
+}
+
+- (void)addTimeline:(MDMTimeline *)timeline {
+  [_tracers addPlanObserver:(id<MDMTargetPlanObserving>)timeline];
+}
+
+- (void)removeTimeline:(MDMTimeline *)timeline {
+  [_tracers removePlanObserver:(id<MDMTargetPlanObserving>)timeline];
 }
 
 - (void)addTracer:(nonnull id<MDMTracing>)tracer {
-  [_tracers addObject:tracer];
+  [_tracers addTracer:tracer];
 }
 
 - (void)removeTracer:(nonnull id<MDMTracing>)tracer {
-  [_tracers removeObject:tracer];
+  [_tracers removeTracer:tracer];
 }
 
 - (nonnull NSArray<id<MDMTracing>> *)tracers {
-  return _tracers.array;
+  return _tracers.tracers;
 }
+
+- (BOOL)isAsynchronousTracingEnabled {
+  return _tracers.isAsynchronous;
+}
+
+- (void)setAsynchronousTracingEnabled:(BOOL)asynchronousTracingEnabled {
+  _tracers.asynchronous = asynchronousTracingEnabled;
+}
+
+- (NSUInteger)droppedTraceEventCount {
+  return _tracers.droppedEventCount;
+}
+
+- (void)flushTracers {
+  [_tracers flush];
+}
+
+- (MDMPerformerLatencyRecorder *)performerLatencyRecorder {
+  return _tracers.latencyRecorder;
+}
+
+- (void)setPerformerLatencyRecorder:(MDMPerformerLatencyRecorder *)performerLatencyRecorder {
+  _tracers.latencyRecorder = performerLatencyRecorder;
+}
+
 @end
@@ -0,0 +1,99 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/** The performer callbacks whose latency can be recorded. */
+typedef NS_ENUM(NSInteger, MDMPerformerCallback) {
+  /** initWithTarget: */
+  MDMPerformerCallbackInitWithTarget,
+
+  /** addPlan: */
+  MDMPerformerCallbackAddPlan,
+
+  /** addPlans:, for performers that implement it. */
+  MDMPerformerCallbackAddPlans,
+
+  /** addPlan:named: */
+  MDMPerformerCallbackAddPlanNamed,
+
+  /** removePlanNamed: */
+  MDMPerformerCallbackRemovePlanNamed,
+
+  /** replacePlanNamed:withPlan: */
+  MDMPerformerCallbackReplacePlanNamed,
+} NS_SWIFT_NAME(PerformerCallback);
+
+/** The latency distribution of one callback of one performer class. */
+NS_SWIFT_NAME(PerformerLatencySummary)
+@interface MDMPerformerLatencySummary : NSObject
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+@property(nonatomic, copy, nonnull, readonly) NSString *performerClassName;
+@property(nonatomic, assign, readonly) MDMPerformerCallback callback;
+
+/** The number of recorded invocations. */
+@property(nonatomic, assign, readonly) uint64_t sampleCount;
+
+/** The median latency, in seconds. Accurate to within 1/16th of the true value. */
+@property(nonatomic, assign, readonly) NSTimeInterval p50Latency;
+
+/** The 99th percentile latency, in seconds. Accurate to within 1/16th of the true value. */
+@property(nonatomic, assign, readonly) NSTimeInterval p99Latency;
+
+/** The exact maximum latency, in seconds. */
+@property(nonatomic, assign, readonly) NSTimeInterval maxLatency;
+
+@end
+
+/**
+ A latency recorder times every performer callback made by a runtime and keeps one histogram per
+ performer class and callback.
+
+ Attach a recorder to a runtime by setting the runtime's performerLatencyRecorder property. Timings
+ are taken with a monotonic clock and recorded into log-linear histograms with 16 sub-buckets per
+ power of two. Each histogram occupies a fixed amount of memory that is allocated the first time
+ its performer class is timed. Recording is lock-free, so summaries may be read from any thread.
+
+ Up to 64 performer classes are tracked. Samples of further classes are counted by
+ droppedSampleCount.
+
+ A recorder should only be attached to a single runtime.
+ */
+NS_SWIFT_NAME(PerformerLatencyRecorder)
+@interface MDMPerformerLatencyRecorder : NSObject
+
+/** The summaries of every performer class and callback with at least one sample. */
+- (nonnull NSArray<MDMPerformerLatencySummary *> *)summaries;
+
+/** Returns the summary for the given performer class and callback if it has any samples. */
+- (nullable MDMPerformerLatencySummary *)summaryForPerformerClass:(nonnull Class)performerClass
+                                                         callback:(MDMPerformerCallback)callback
+    NS_SWIFT_NAME(summary(for:callback:));
+
+/** The number of samples that were discarded because too many performer classes were timed. */
+@property(nonatomic, assign, readonly) uint64_t droppedSampleCount;
+
+/**
+ Discards all recorded samples.
+
+ Samples recorded while the reset is in progress may be partially retained.
+ */
+- (void)reset;
+
+@end
@@ -0,0 +1,254 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMPerformerLatencyRecorder.h"
+#import "private/MDMPerformerLatencyRecorder+Private.h"
+
+#import <stdatomic.h>
+#import <stdlib.h>
+
+enum {
+  // The number of performer classes whose samples are recorded.
+  kMaxPerformerClassCount = 64,
+
+  kPerformerCallbackCount = MDMPerformerCallbackReplacePlanNamed + 1,
+
+  // Values below kSubBucketCount are recorded exactly. Larger values are recorded in one of
+  // kSubBucketCount linear sub-buckets of their power of two.
+  kSubBucketBits = 4,
+  kSubBucketCount = 1 << kSubBucketBits,
+
+  // Values of 2^(kMaxExponent + 1) nanoseconds (about 36 minutes) or more share the last bucket.
+  kMaxExponent = 40,
+  kBucketCount = kSubBucketCount + (kMaxExponent - kSubBucketBits + 1) * kSubBucketCount,
+};
+
+typedef struct {
+  _Atomic(uint64_t) count;
+  _Atomic(uint64_t) max;
+  _Atomic(uint32_t) buckets[kBucketCount];
+} MDMLatencyHistogram;
+
+typedef struct {
+  // Unretained; classes are never deallocated.
+  const void *performerClass;
+  MDMLatencyHistogram histograms[kPerformerCallbackCount];
+} MDMPerformerLatencyHistograms;
+
+static NSUInteger MDMLatencyBucketForValue(uint64_t value) {
+  if (value < kSubBucketCount) {
+    return (NSUInteger)value;
+  }
+  NSUInteger exponent = 63 - (NSUInteger)__builtin_clzll(value);
+  if (exponent > kMaxExponent) {
+    return kBucketCount - 1;
+  }
+  NSUInteger shift = exponent - kSubBucketBits;
+  NSUInteger subBucket = (NSUInteger)(value >> shift) - kSubBucketCount;
+  return kSubBucketCount + shift * kSubBucketCount + subBucket;
+}
+
+// The largest value recorded in the given bucket.
+static uint64_t MDMLatencyBucketUpperBound(NSUInteger bucket) {
+  if (bucket < kSubBucketCount) {
+    return bucket;
+  }
+  NSUInteger shift = (bucket - kSubBucketCount) / kSubBucketCount;
+  NSUInteger subBucket = (bucket - kSubBucketCount) % kSubBucketCount;
+  return ((uint64_t)(kSubBucketCount + subBucket + 1) << shift) - 1;
+}
+
+static NSTimeInterval MDMSecondsFromNanoseconds(uint64_t nanoseconds) {
+  return (NSTimeInterval)nanoseconds / 1e9;
+}
+
+@interface MDMPerformerLatencySummary ()
+
+- (instancetype)initWithPerformerClassName:(NSString *)performerClassName
+                                  callback:(MDMPerformerCallback)callback
+                                 histogram:(MDMLatencyHistogram *)histogram;
+
+@end
+
+@implementation MDMPerformerLatencySummary
+
+- (instancetype)initWithPerformerClassName:(NSString *)performerClassName
+                                  callback:(MDMPerformerCallback)callback
+                                 histogram:(MDMLatencyHistogram *)histogram {
+  self = [super init];
+  if (self) {
+    _performerClassName = [performerClassName copy];
+    _callback = callback;
+
+    // Copy the buckets first so that the percentiles are computed over a consistent sample count.
+    uint32_t *buckets = calloc(kBucketCount, sizeof(uint32_t));
+    uint64_t total = 0;
+    for (NSUInteger bucket = 0; bucket < kBucketCount; bucket++) {
+      buckets[bucket] = atomic_load_explicit(&histogram->buckets[bucket], memory_order_relaxed);
+      total += buckets[bucket];
+    }
+    uint64_t max = atomic_load_explicit(&histogram->max, memory_order_relaxed);
+
+    _sampleCount = total;
+    _p50Latency = MDMSecondsFromNanoseconds(MIN(max, [self valueAtQuantile:0.5
+                                                                   buckets:buckets
+                                                                     total:total]));
+    _p99Latency = MDMSecondsFromNanoseconds(MIN(max, [self valueAtQuantile:0.99
+                                                                   buckets:buckets
+                                                                     total:total]));
+    _maxLatency = MDMSecondsFromNanoseconds(max);
+    free(buckets);
+  }
+  return self;
+}
+
+- (uint64_t)valueAtQuantile:(double)quantile buckets:(uint32_t *)buckets total:(uint64_t)total {
+  uint64_t rank = (uint64_t)ceil(quantile * (double)total);
+  uint64_t cumulative = 0;
+  for (NSUInteger bucket = 0; bucket < kBucketCount; bucket++) {
+    cumulative += buckets[bucket];
+    if (cumulative >= rank && cumulative > 0) {
+      return MDMLatencyBucketUpperBound(bucket);
+    }
+  }
+  return 0;
+}
+
+@end
+
+@implementation MDMPerformerLatencyRecorder {
+  // Indexed by performer slot. Allocated on first use and never freed before dealloc.
+  _Atomic(MDMPerformerLatencyHistograms *) _histogramsBySlot[kMaxPerformerClassCount];
+  _Atomic(uint64_t) _droppedSampleCount;
+}
+
+- (void)dealloc {
+  for (NSUInteger slot = 0; slot < kMaxPerformerClassCount; slot++) {
+    free(atomic_load_explicit(&_histogramsBySlot[slot], memory_order_relaxed));
+  }
+}
+
+#pragma mark - Recording
+
+- (void)recordNanoseconds:(uint64_t)nanoseconds
+               ofCallback:(MDMPerformerCallback)callback
+            performerSlot:(NSUInteger)performerSlot
+           performerClass:(Class)performerClass {
+  if (performerSlot >= kMaxPerformerClassCount) {
+    atomic_fetch_add_explicit(&_droppedSampleCount, 1, memory_order_relaxed);
+    return;
+  }
+
+  MDMPerformerLatencyHistograms *histograms =
+      atomic_load_explicit(&_histogramsBySlot[performerSlot], memory_order_acquire);
+  if (!histograms) {
+    MDMPerformerLatencyHistograms *allocated = calloc(1, sizeof(MDMPerformerLatencyHistograms));
+    allocated->performerClass = (__bridge const void *)performerClass;
+    MDMPerformerLatencyHistograms *expected = NULL;
+    if (atomic_compare_exchange_strong_explicit(&_histogramsBySlot[performerSlot], &expected,
+                                                allocated, memory_order_acq_rel,
+                                                memory_order_acquire)) {
+      histograms = allocated;
+    } else {
+      free(allocated);
+      histograms = expected;
+    }
+  }
+
+  MDMLatencyHistogram *histogram = &histograms->histograms[callback];
+  atomic_fetch_add_explicit(&histogram->buckets[MDMLatencyBucketForValue(nanoseconds)], 1,
+                            memory_order_relaxed);
+  atomic_fetch_add_explicit(&histogram->count, 1, memory_order_relaxed);
+
+  uint64_t max = atomic_load_explicit(&histogram->max, memory_order_relaxed);
+  while (nanoseconds > max
+         && !atomic_compare_exchange_weak_explicit(&histogram->max, &max, nanoseconds,
+                                                   memory_order_relaxed, memory_order_relaxed)) {
+  }
+}
+
+#pragma mark - Public
+
+- (NSArray<MDMPerformerLatencySummary *> *)summaries {
+  NSMutableArray<MDMPerformerLatencySummary *> *summaries = [NSMutableArray array];
+  for (NSUInteger slot = 0; slot < kMaxPerformerClassCount; slot++) {
+    MDMPerformerLatencyHistograms *histograms =
+        atomic_load_explicit(&_histogramsBySlot[slot], memory_order_acquire);
+    if (!histograms) {
+      continue;
+    }
+    for (NSUInteger callback = 0; callback < kPerformerCallbackCount; callback++) {
+      MDMPerformerLatencySummary *summary =
+          [self summaryOfHistograms:histograms callback:(MDMPerformerCallback)callback];
+      if (summary) {
+        [summaries addObject:summary];
+      }
+    }
+  }
+  return summaries;
+}
+
+- (MDMPerformerLatencySummary *)summaryForPerformerClass:(Class)performerClass
+                                                callback:(MDMPerformerCallback)callback {
+  for (NSUInteger slot = 0; slot < kMaxPerformerClassCount; slot++) {
+    MDMPerformerLatencyHistograms *histograms =
+        atomic_load_explicit(&_histogramsBySlot[slot], memory_order_acquire);
+    if (histograms && histograms->performerClass == (__bridge const void *)performerClass) {
+      return [self summaryOfHistograms:histograms callback:callback];
+    }
+  }
+  return nil;
+}
+
+- (uint64_t)droppedSampleCount {
+  return atomic_load_explicit(&_droppedSampleCount, memory_order_relaxed);
+}
+
+- (void)reset {
+  for (NSUInteger slot = 0; slot < kMaxPerformerClassCount; slot++) {
+    MDMPerformerLatencyHistograms *histograms =
+        atomic_load_explicit(&_histogramsBySlot[slot], memory_order_acquire);
+    if (!histograms) {
+      continue;
+    }
+    for (NSUInteger callback = 0; callback < kPerformerCallbackCount; callback++) {
+      MDMLatencyHistogram *histogram = &histograms->histograms[callback];
+      for (NSUInteger bucket = 0; bucket < kBucketCount; bucket++) {
+        atomic_store_explicit(&histogram->buckets[bucket], 0, memory_order_relaxed);
+      }
+      atomic_store_explicit(&histogram->count, 0, memory_order_relaxed);
+      atomic_store_explicit(&histogram->max, 0, memory_order_relaxed);
+    }
+  }
+  atomic_store_explicit(&_droppedSampleCount, 0, memory_order_relaxed);
+}
+
+#pragma mark - Private
+
+- (MDMPerformerLatencySummary *)summaryOfHistograms:(MDMPerformerLatencyHistograms *)histograms
+                                           callback:(MDMPerformerCallback)callback {
+  MDMLatencyHistogram *histogram = &histograms->histograms[callback];
+  if (atomic_load_explicit(&histogram->count, memory_order_relaxed) == 0) {
+    return nil;
+  }
+  Class performerClass = (__bridge Class)histograms->performerClass;
+  return [[MDMPerformerLatencySummary alloc]
+      initWithPerformerClassName:NSStringFromClass(performerClass)
+                        callback:callback
+                       histogram:histogram];
+}
+
+@end
@@ -44,6 +44,19 @@ NS_SWIFT_NAME(Performing)
 - (void)addPlan:(nonnull id<MDMPlan>)plan
     NS_SWIFT_NAME(addPlan(_:));
 
+@optional
+
+/**
+ Provides the performer with a batch of plans.
+
+ Invoked instead of addPlan: when plans are added to the runtime with addPlans:to: and the
+ performer implements this method. Plans are provided in the order in which they were added.
+
+ @param plans The plans that required this type of performer.
+ */
+- (void)addPlans:(nonnull NSArray<id<MDMPlan>> *)plans
+    NS_SWIFT_NAME(addPlans(_:));
+
 @end
 
 /** Specifics for a named plan performer to allow named plans to be added and removed. */
@@ -68,6 +81,37 @@ NS_SWIFT_NAME(NamedPlanPerforming)
 - (void)removePlanNamed:(nonnull NSString *)name
     NS_SWIFT_NAME(removePlan(named:));
 
+@optional
+
+/**
+ Replaces the plan associated with a name with a new plan.
+
+ Invoked instead of removePlanNamed: followed by addPlan:named: when a named plan is replaced by a
+ plan for the same performer. Tracers only observe the addition.
+
+ @param name The name by which the plans can be identified.
+ @param plan The plan that replaces the current plan.
+ */
+- (void)replacePlanNamed:(nonnull NSString *)name
+                withPlan:(nonnull id<MDMNamedPlan>)plan
+    NS_SWIFT_NAME(replacePlan(named:with:));
+
+@end
+
+#pragma mark - Rehydration
+
+/**
+ A performer conforming to MDMRehydratablePerforming can be evicted by its runtime while it is idle.
+
+ A performer is idle when none of its tokens are active and it holds no named plans. While the
+ runtime has a performer budget, it retains the unnamed plans it gives to a rehydratable performer.
+ If a plan arrives for an evicted performer, the runtime creates a new performer and gives it the
+ retained plans, in their original order, before the new plan.
+
+ Conform only if a performer's state can be rebuilt entirely from its plans.
+ */
+NS_SWIFT_NAME(RehydratablePerforming)
+@protocol MDMRehydratablePerforming <MDMPerforming>
 @end
 
 #pragma mark - Continuous performing
@@ -118,6 +162,30 @@ NS_SWIFT_NAME(Tokened)
 
 @end
 
+/**
+ A token group changes the active state of many tokens in one operation.
+
+ Activating or deactivating the group informs the runtime once per run of consecutive tokens that
+ share a target and performer class, rather than once per token. Tokens generated for the plans of
+ a single performer form one run, making token groups the preferred way for a performer to start or
+ stop many plans at once. Interleaving the tokens of several targets or performer classes splits
+ them into more runs.
+ */
+NS_SWIFT_NAME(TokenGroup)
+@protocol MDMTokenGroup <NSObject>
+
+/** The number of tokens in the group. */
+@property(nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ Setting this property activates or deactivates every token in the group.
+
+ Reading this property returns YES if any token in the group is active.
+ */
+@property(nonatomic, assign, getter=isActive) BOOL active;
+
+@end
+
 /** A tokenizer turns plans into motion tokens. */
 NS_SWIFT_NAME(PlanTokenizing)
 @protocol MDMPlanTokenizing <NSObject>
@@ -130,10 +198,26 @@ NS_SWIFT_NAME(PlanTokenizing)
 
  May fail to generate a token if the performer's runtime has been deallocated.
 
- Will always return the same token instance for a given plan instance.
+ Will always return the same token instance for a given plan instance. An immutable plan instance
+ that was added to several targets has a distinct token for each target.
  */
 - (nullable id<MDMTokened>)tokenForPlan:(nonnull id<MDMPlan>)plan;
 
+@optional
+
+/**
+ Returns a group containing the tokens for the given plans.
+
+ Each member of the group is the same instance that tokenForPlan: returns for its plan. Plans that
+ can't generate a token are skipped.
+
+ Optional so that existing tokenizers remain source compatible. Performers should fall back to
+ tokenForPlan: for each plan if the tokenizer doesn't implement this method. The runtime's
+ tokenizers always do.
+ */
+- (nonnull id<MDMTokenGroup>)tokenGroupForPlans:(nonnull NSArray<id<MDMPlan>> *)plans
+    NS_SWIFT_NAME(tokenGroup(for:));
+
 @end
 
 #pragma mark - Composition
@@ -145,7 +229,12 @@ NS_SWIFT_NAME(PlanTokenizing)
 NS_SWIFT_NAME(PlanEmitting)
 @protocol MDMPlanEmitting <NSObject>
 
-/** Emit a new plan. The plan will immediately be added to the backing runtime. */
+/**
+ Emit a new plan.
+
+ If the runtime is in the middle of adding a plan, the emitted plan is added once the outermost
+ addition completes. Otherwise the plan is added immediately.
+ */
 - (void)emitPlan:(nonnull NSObject<MDMPlan> *)plan
     NS_SWIFT_NAME(emitPlan(_:));
 
@@ -162,3 +251,54 @@ NS_SWIFT_NAME(ComposablePerforming)
     NS_SWIFT_NAME(setPlanEmitter(_:));
 
 @end
+
+#pragma mark - Frame scheduling
+
+/** A stepper advances some continuous work, such as a simulation, once per frame. */
+NS_SWIFT_NAME(FrameStepping)
+@protocol MDMFrameStepping <NSObject>
+
+/**
+ Advances the receiver's work by the given interval.
+
+ @return YES if the work has come to rest, in which case the receiver is unscheduled.
+ */
+- (BOOL)stepByTimeInterval:(NSTimeInterval)interval
+    NS_SWIFT_NAME(step(by:));
+
+@end
+
+/**
+ A frame scheduler steps every scheduled stepper once per tick of the runtime's frame clock.
+
+ Steppers are stepped in one loop, grouped by class.
+ */
+NS_SWIFT_NAME(FrameScheduling)
+@protocol MDMFrameScheduling <NSObject>
+
+/**
+ Starts stepping the stepper on every tick and activates the token.
+
+ When the stepper reports that it has come to rest, it is unscheduled and the token is
+ deactivated. Does nothing if the stepper is already scheduled. The stepper and token are strongly
+ held while scheduled.
+ */
+- (void)scheduleStepper:(nonnull id<MDMFrameStepping>)stepper
+                  token:(nullable id<MDMTokened>)token
+    NS_SWIFT_NAME(schedule(_:token:));
+
+/** Stops stepping the stepper and deactivates its token. Does nothing if it is not scheduled. */
+- (void)unscheduleStepper:(nonnull id<MDMFrameStepping>)stepper
+    NS_SWIFT_NAME(unschedule(_:));
+
+@end
+
+/** A performer conforming to MDMFrameScheduledPerforming is stepped by its runtime's clock. */
+NS_SWIFT_NAME(FrameScheduledPerforming)
+@protocol MDMFrameScheduledPerforming <MDMContinuousPerforming>
+
+/** Provides the performer with its runtime's frame scheduler before any plans are added. */
+- (void)setFrameScheduler:(nonnull id<MDMFrameScheduling>)frameScheduler
+    NS_SWIFT_NAME(setFrameScheduler(_:));
+
+@end
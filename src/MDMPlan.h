@@ -43,3 +43,46 @@ NS_SWIFT_NAME(NamedPlan)
 @protocol MDMNamedPlan <MDMPlan>
 
 @end
+
+/**
+ A plan conforming to MDMImmutablePlan promises that it will never be mutated.
+
+ The runtime retains immutable plans instead of copying them when they are added, which avoids an
+ allocation per addition. Conform to this protocol only if no property of the plan can change after
+ it has been initialized.
+ */
+NS_SWIFT_NAME(ImmutablePlan)
+@protocol MDMImmutablePlan <MDMPlan>
+
+@end
+
+/**
+ A plan conforming to MDMReplayablePlan promises that its performer only emits plans, and that the
+ emitted plans depend only on the plan's configuration.
+
+ The first time a replayable plan is added to a runtime, the plans that its performer emits from
+ within addPlan: are recorded as a template keyed by the plan's isEqual: and hash. Later additions
+ of an equal plan skip the plan's performer entirely and queue copies of the recorded plans as if
+ they had been emitted. Replayable plans emitted while recording are flattened into their own
+ templates when those are known.
+
+ The plan must implement isEqual: and hash in terms of its configuration. Use
+ -[MDMMotionRuntime invalidatePlanTemplatesForPlanClass:] when the expansion of a plan class
+ changes.
+ */
+NS_SWIFT_NAME(ReplayablePlan)
+@protocol MDMReplayablePlan <MDMPlan>
+
+@end
+
+/**
+ A plan conforming to MDMEquatablePlan implements isEqual: and hash in terms of its configuration,
+ such that adding a plan equal to one already added to the same target has no further effect.
+
+ When -[MDMMotionRuntime deduplicatesEquatablePlans] is enabled, the runtime skips additions of
+ equatable plans that are equal to a plan previously added to the same target.
+ */
+NS_SWIFT_NAME(EquatablePlan)
+@protocol MDMEquatablePlan <MDMPlan>
+
+@end
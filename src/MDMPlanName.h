@@ -0,0 +1,53 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ An interned handle for the name of a named plan.
+
+ There is exactly one MDMPlanName instance per distinct string for the lifetime of the process, so
+ plan names can be compared and looked up by identity. Target scopes key their named plans by the
+ handle's identifier, which means that adding or removing a named plan with a handle never hashes
+ a string.
+
+ Creating a handle hashes its string once. Hot paths that repeatedly add or remove the same named
+ plan should create the handle once and reuse it.
+
+ Handles returned by planNameWithString: are never deallocated. Avoid creating them from unbounded
+ sets of strings. The runtime's NSString-based methods use handles that are deallocated once no
+ named plan, transaction or enqueued command refers to them.
+ */
+NS_SWIFT_NAME(PlanName)
+@interface MDMPlanName : NSObject <NSCopying>
+
+/** Returns the unique handle for the given non-empty string, creating it if needed. Thread-safe. */
++ (nonnull instancetype)planNameWithString:(nonnull NSString *)string NS_SWIFT_NAME(init(_:));
+
+/** Returns the unique handle for the given string if one is alive. Thread-safe. */
++ (nullable instancetype)existingPlanNameWithString:(nonnull NSString *)string
+    NS_SWIFT_NAME(existing(_:));
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/** The name's string. */
+@property(nonatomic, copy, nonnull, readonly) NSString *string;
+
+/** A process-unique identifier. Identifiers are assigned densely starting at 1. */
+@property(nonatomic, assign, readonly) NSUInteger identifier;
+
+@end
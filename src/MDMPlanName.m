@@ -0,0 +1,105 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMPlanName.h"
+#import "private/MDMPlanName+Private.h"
+
+#import <pthread.h>
+
+static pthread_mutex_t symbolTableLock = PTHREAD_MUTEX_INITIALIZER;
+// Maps strings to live handles. Transient handles remove their entry when deallocated.
+static NSMapTable<NSString *, MDMPlanName *> *symbolTable;
+// Keeps permanent handles alive.
+static NSMutableArray<MDMPlanName *> *permanentNames;
+static NSUInteger lastIdentifier;
+
+// Must be invoked with symbolTableLock held.
+static MDMPlanName *lockedPlanNameWithString(NSString *string) {
+  if (!symbolTable) {
+    symbolTable = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsCopyIn
+                                        valueOptions:NSPointerFunctionsWeakMemory];
+    permanentNames = [NSMutableArray array];
+  }
+  MDMPlanName *name = [symbolTable objectForKey:string];
+  if (!name) {
+    name = [[MDMPlanName alloc] initWithString:string identifier:++lastIdentifier];
+    [symbolTable setObject:name forKey:name.string];
+  }
+  return name;
+}
+
+@implementation MDMPlanName
+
+- (instancetype)initWithString:(NSString *)string identifier:(NSUInteger)identifier {
+  self = [super init];
+  if (self) {
+    _string = [string copy];
+    _identifier = identifier;
+  }
+  return self;
+}
+
+- (void)dealloc {
+  // Released after unlocking: releasing the last reference to a handle while holding the lock
+  // would deadlock in its dealloc.
+  MDMPlanName *current;
+  pthread_mutex_lock(&symbolTableLock);
+  current = [symbolTable objectForKey:_string];
+  // A new handle for the same string may already have replaced this one.
+  if (!current) {
+    [symbolTable removeObjectForKey:_string];
+  }
+  pthread_mutex_unlock(&symbolTableLock);
+}
+
++ (instancetype)planNameWithString:(NSString *)string {
+  NSParameterAssert(string.length > 0);
+
+  pthread_mutex_lock(&symbolTableLock);
+  MDMPlanName *name = lockedPlanNameWithString(string);
+  if (!name->_permanent) {
+    name->_permanent = YES;
+    [permanentNames addObject:name];
+  }
+  pthread_mutex_unlock(&symbolTableLock);
+  return name;
+}
+
++ (instancetype)transientPlanNameWithString:(NSString *)string {
+  NSParameterAssert(string.length > 0);
+
+  pthread_mutex_lock(&symbolTableLock);
+  MDMPlanName *name = lockedPlanNameWithString(string);
+  pthread_mutex_unlock(&symbolTableLock);
+  return name;
+}
+
++ (instancetype)existingPlanNameWithString:(NSString *)string {
+  pthread_mutex_lock(&symbolTableLock);
+  MDMPlanName *name = [symbolTable objectForKey:string];
+  pthread_mutex_unlock(&symbolTableLock);
+  return name;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return self;
+}
+
+- (NSString *)description {
+  return _string;
+}
+
+@end
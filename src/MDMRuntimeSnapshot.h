@@ -0,0 +1,107 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/** Determines how much detail an MDMRuntimeSnapshot captures. */
+typedef NS_OPTIONS(NSUInteger, MDMRuntimeSnapshotOptions) {
+  MDMRuntimeSnapshotOptionNone = 0,
+
+  /** Captures one MDMRuntimeTargetSnapshot per target. Allocates one object per target. */
+  MDMRuntimeSnapshotOptionTargetBreakdown = 1 << 0,
+} NS_SWIFT_NAME(RuntimeSnapshotOptions);
+
+/** The portion of a runtime snapshot attributed to a single target. */
+NS_SWIFT_NAME(RuntimeTargetSnapshot)
+@interface MDMRuntimeTargetSnapshot : NSObject
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/** The target. nil if the target has been deallocated since the snapshot was taken. */
+@property(nonatomic, weak, nullable, readonly) id target;
+
+@property(nonatomic, assign, readonly) NSUInteger performerCount;
+@property(nonatomic, assign, readonly) NSUInteger namedPlanCount;
+@property(nonatomic, assign, readonly) NSUInteger activeTokenCount;
+
+/** An estimate of the bytes held by the target's scope, performers and retained plans. */
+@property(nonatomic, assign, readonly) NSUInteger estimatedByteCount;
+
+@end
+
+/**
+ A point-in-time summary of the objects held by a runtime.
+
+ Byte counts are estimates based on instance sizes. They exclude memory owned indirectly by
+ performers and plans, such as collections or animations.
+ */
+NS_SWIFT_NAME(RuntimeSnapshot)
+@interface MDMRuntimeSnapshot : NSObject
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+#pragma mark Counts
+
+/** The number of targets that currently have a scope. */
+@property(nonatomic, assign, readonly) NSUInteger targetScopeCount;
+
+/** The number of live performers. Evicted performers are not counted. */
+@property(nonatomic, assign, readonly) NSUInteger performerCount;
+
+/** The number of tokens that have been handed out for plans that are still alive. */
+@property(nonatomic, assign, readonly) NSUInteger tokenCount;
+
+@property(nonatomic, assign, readonly) NSUInteger activeTokenCount;
+@property(nonatomic, assign, readonly) NSUInteger namedPlanCount;
+
+/**
+ The number of unnamed plans retained to rehydrate evicted performers. Plans are only retained
+ while a performer budget is set.
+ */
+@property(nonatomic, assign, readonly) NSUInteger retainedPlanCount;
+
+@property(nonatomic, assign, readonly) NSUInteger tracerCount;
+
+#pragma mark Memory
+
+/** An estimate of the bytes held by the runtime's scopes, performers, retained plans and tokens. */
+@property(nonatomic, assign, readonly) NSUInteger estimatedByteCount;
+
+/** The number of live performers keyed by performer class name. */
+@property(nonatomic, copy, nonnull, readonly)
+    NSDictionary<NSString *, NSNumber *> *performerCountByClassName;
+
+/** The estimated bytes held by live performers keyed by performer class name. */
+@property(nonatomic, copy, nonnull, readonly)
+    NSDictionary<NSString *, NSNumber *> *estimatedPerformerByteCountByClassName;
+
+/** Per-target details. nil unless MDMRuntimeSnapshotOptionTargetBreakdown was requested. */
+@property(nonatomic, copy, nullable, readonly) NSArray<MDMRuntimeTargetSnapshot *> *targets;
+
+#pragma mark High-water marks
+
+/** The largest number of target scopes the runtime has held at once. */
+@property(nonatomic, assign, readonly) NSUInteger peakTargetScopeCount;
+
+/** The largest number of live performers the runtime has held at once. */
+@property(nonatomic, assign, readonly) NSUInteger peakPerformerCount;
+
+/** The largest number of tokens that have been active at once. */
+@property(nonatomic, assign, readonly) NSUInteger peakActiveTokenCount;
+
+@end
@@ -0,0 +1,55 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMRuntimeSnapshot.h"
+#import "private/MDMRuntimeSnapshot+Private.h"
+
+@implementation MDMRuntimeTargetSnapshot
+
+- (instancetype)initWithTarget:(id)target {
+  self = [super init];
+  if (self) {
+    _target = target;
+  }
+  return self;
+}
+
+@end
+
+@implementation MDMRuntimeSnapshot
+
+- (instancetype)initInternal {
+  self = [super init];
+  if (self) {
+    _performerCountByClassName = @{};
+    _estimatedPerformerByteCountByClassName = @{};
+  }
+  return self;
+}
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p; targetScopes = %lu; performers = %lu; tokens = %lu; "
+                                    @"activeTokens = %lu; namedPlans = %lu; tracers = %lu; "
+                                    @"estimatedBytes = %lu>",
+                                    NSStringFromClass([self class]), (void *)self,
+                                    (unsigned long)_targetScopeCount,
+                                    (unsigned long)_performerCount, (unsigned long)_tokenCount,
+                                    (unsigned long)_activeTokenCount,
+                                    (unsigned long)_namedPlanCount, (unsigned long)_tracerCount,
+                                    (unsigned long)_estimatedByteCount];
+}
+
+@end
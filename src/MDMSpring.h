@@ -0,0 +1,65 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMPlan.h"
+
+/** The stiffness of springs created without an explicit stiffness. */
+FOUNDATION_EXTERN const double MDMSpringDefaultStiffness NS_SWIFT_NAME(Spring.defaultStiffness);
+
+/** The damping of springs created without an explicit damping. */
+FOUNDATION_EXTERN const double MDMSpringDefaultDamping NS_SWIFT_NAME(Spring.defaultDamping);
+
+/**
+ Pulls the numeric value at a key path of the target towards a destination.
+
+ Springs are integrated by the runtime's built-in motion solver on every tick of the runtime's
+ frameClock, together with every other active spring and tween of the runtime. The spring's token
+ is active until the value comes to rest at the destination.
+
+ Adding a spring for a key path that is already animating retargets the existing motion and
+ preserves its velocity. Otherwise the motion starts from the key path's current value.
+ */
+NS_SWIFT_NAME(Spring)
+@interface MDMSpring : NSObject <MDMNamedPlan, MDMImmutablePlan>
+
+/** Initializes a spring with the default stiffness and damping. */
+- (nonnull instancetype)initWithKeyPath:(nonnull NSString *)keyPath
+                            destination:(double)destination;
+
+/** Initializes a spring of unit mass. */
+- (nonnull instancetype)initWithKeyPath:(nonnull NSString *)keyPath
+                            destination:(double)destination
+                              stiffness:(double)stiffness
+                                damping:(double)damping NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/** The key path of the target's value. The value must be a number. */
+@property(nonatomic, copy, nonnull, readonly) NSString *keyPath;
+
+/** The value at which the spring comes to rest. */
+@property(nonatomic, assign, readonly) double destination;
+
+/** The force per unit of distance from the destination. */
+@property(nonatomic, assign, readonly) double stiffness;
+
+/** The force per unit of velocity opposing the motion. */
+@property(nonatomic, assign, readonly) double damping;
+
+@end
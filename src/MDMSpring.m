@@ -0,0 +1,57 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMSpring.h"
+
+#import "private/MDMMotionSolverPerformer.h"
+
+const double MDMSpringDefaultStiffness = 342;
+const double MDMSpringDefaultDamping = 30;
+
+@implementation MDMSpring
+
+- (instancetype)initWithKeyPath:(NSString *)keyPath destination:(double)destination {
+  return [self initWithKeyPath:keyPath
+                   destination:destination
+                     stiffness:MDMSpringDefaultStiffness
+                       damping:MDMSpringDefaultDamping];
+}
+
+- (instancetype)initWithKeyPath:(NSString *)keyPath
+                    destination:(double)destination
+                      stiffness:(double)stiffness
+                        damping:(double)damping {
+  self = [super init];
+  if (self) {
+    _keyPath = [keyPath copy];
+    _destination = destination;
+    _stiffness = stiffness;
+    _damping = damping;
+  }
+  return self;
+}
+
+#pragma mark - MDMPlan
+
+- (Class)performerClass {
+  return [MDMMotionSolverPerformer class];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return self;
+}
+
+@end
@@ -16,8 +16,38 @@
 
 #import <Foundation/Foundation.h>
 
+@protocol MDMClock;
 @protocol MDMTimelineObserving;
 
+/** Determines when timeline observers are informed of changes to a scrubber's timeOffset. */
+typedef NS_ENUM(NSInteger, MDMTimelineScrubDelivery) {
+  /** Observers are informed synchronously of every change. */
+  MDMTimelineScrubDeliveryImmediate,
+
+  /**
+   Changes are coalesced and observers are informed of the latest timeOffset at most once per tick
+   of the timeline's clock.
+   */
+  MDMTimelineScrubDeliveryClock,
+} NS_SWIFT_NAME(TimelineScrubDelivery);
+
+/**
+ A function from a timeline's time offset to a value.
+
+ Timelines cache the curve's values, so it should return the same value for the same offset until
+ the timeline resamples it.
+ */
+typedef double (^MDMTimelineCurve)(NSTimeInterval timeOffset) NS_SWIFT_NAME(TimelineCurve);
+
+/**
+ Receives the value of a timeline curve at a scrubber's time offset, along with the curve's target.
+
+ The target is passed in so that the applier doesn't need to capture it. Timelines retain their
+ appliers, so an applier that strongly captures its target keeps the target and its curves alive.
+ */
+typedef void (^MDMTimelineCurveApplier)(id _Nonnull target, double value)
+    NS_SWIFT_NAME(TimelineCurveApplier);
+
 /** A scrubber can be attached to a timeline in order to control the timeline's timeOffset. */
 NS_SWIFT_NAME(TimelineScrubber)
 @interface MDMTimelineScrubber : NSObject
@@ -33,11 +63,30 @@ NS_SWIFT_NAME(TimelineScrubber)
 
 @end
 
-/** A timeline provides an API for scrubbing time. */
+/**
+ A timeline provides an API for scrubbing time.
+
+ Adding a timeline to a runtime with -[MDMMotionRuntime addTimeline:] lets the timeline resample
+ the curves of targets whose plans change. The timeline is informed of plan changes synchronously,
+ on the runtime's thread, even when the runtime's asynchronous tracing is enabled.
+ */
 NS_SWIFT_NAME(Timeline)
 @interface MDMTimeline : NSObject
 
-/** Populates beginTime with the current absolute time. Can only be invoked once. */
+/** Initializes a timeline whose clock is a new MDMMonotonicClock. */
+- (nonnull instancetype)init;
+
+/**
+ Initializes a timeline that reads time from the given clock.
+
+ Use an MDMVirtualClock to run the timeline faster than real time with deterministic results.
+ */
+- (nonnull instancetype)initWithClock:(nonnull id<MDMClock>)clock NS_DESIGNATED_INITIALIZER;
+
+/** The clock from which the timeline reads time. */
+@property(nonatomic, strong, nonnull, readonly) id<MDMClock> clock;
+
+/** Populates beginTime with the clock's current time. Can only be invoked once. */
 - (void)begin;
 
 /** The time at which the timeline began, if it has. */
@@ -67,12 +116,60 @@ NS_SWIFT_NAME(Timeline)
  */
 @property(nonatomic, strong, nullable, readonly) MDMTimelineScrubber *scrubber;
 
+/**
+ Determines when observers are informed of changes to the scrubber's timeOffset.
+
+ Defaults to MDMTimelineScrubDeliveryImmediate. MDMTimelineScrubDeliveryClock protects observers
+ from input that changes the offset more often than the clock ticks. Attachment and detachment
+ events are always delivered immediately, and a pending offset is discarded when the scrubber is
+ detached. Switching back to MDMTimelineScrubDeliveryImmediate delivers any pending offset.
+ */
+@property(nonatomic, assign) MDMTimelineScrubDelivery scrubDelivery;
+
 /** Add a timeline observer to the timeline. */
 - (void)addTimelineObserver:(nonnull id<MDMTimelineObserving>)observer;
 
 /** Remove a timeline observer from the timeline. */
 - (void)removeTimelineObserver:(nonnull id<MDMTimelineObserving>)observer;
 
+#pragma mark Sampled curves
+
+/**
+ Registers a curve whose value is passed to the applier whenever the scrubber's timeOffset is
+ delivered, before observers are informed.
+
+ Instead of evaluating the curve on every scrub, the timeline samples it once over [0, duration]
+ into a table and resolves scrubs by interpolating between table entries. Offsets outside of the
+ duration are clamped. A performer that would otherwise recompute its motion in
+ timeline:scrubberDidScrub: can register its curves once when the scrubber is attached.
+
+ The target's curves are resampled after a plan is added to or removed from the target in any
+ runtime that the timeline was added to. Curves, scrubs and plan changes must all happen on the same
+ thread.
+
+ The curves are removed when the target is deallocated. The timeline retains the curve and the
+ applier, so neither should strongly capture the target.
+ */
+- (void)addCurve:(nonnull MDMTimelineCurve)curve
+        duration:(NSTimeInterval)duration
+       forTarget:(nonnull id)target
+         applier:(nonnull MDMTimelineCurveApplier)applier
+    NS_SWIFT_NAME(addCurve(_:duration:for:applier:));
+
+/** Removes every curve registered for the target. */
+- (void)removeCurvesForTarget:(nonnull id)target
+    NS_SWIFT_NAME(removeCurves(for:));
+
+/**
+ The number of samples taken per second of curve duration. Defaults to 240.
+
+ Changing the rate resamples every curve.
+ */
+@property(nonatomic, assign) double curveSampleRate;
+
+/** The number of registered curves. */
+@property(nonatomic, assign, readonly) NSUInteger curveCount;
+
 @end
 
 /** A timeline observer may receive events in relation to state changes from a Timeline instance. */
@@ -16,9 +16,12 @@
 
 #import "MDMTimeline.h"
 
-#import <QuartzCore/QuartzCore.h>
+#import "MDMClock.h"
+#import "MDMMonotonicClock.h"
+#import "private/MDMSampledCurveTable.h"
+#import "private/MDMTracerTable.h"
 
-@interface MDMTimeline ()
+@interface MDMTimeline () <MDMClockObserving, MDMTargetPlanObserving>
 - (void)scrubberDidScrub:(NSTimeInterval)timeOffset;
 @end
 
@@ -52,23 +55,44 @@
   MDMTimelineScrubber *_scrubber;
   NSHashTable *_observers;
   BOOL _isScrubberAttached;
+
+  // The observers in a contiguous array for coalesced delivery. Rebuilt when observers change.
+  // Observers are weakly held, matching _observers.
+  NSPointerArray *_observerSnapshot;
+
+  BOOL _hasPendingScrub;
+  NSTimeInterval _pendingTimeOffset;
+
+  MDMSampledCurveTable *_curveTable;
 }
 
 - (instancetype)init {
+  return [self initWithClock:[MDMMonotonicClock new]];
+}
+
+- (instancetype)initWithClock:(id<MDMClock>)clock {
   self = [super init];
   if (self) {
+    _clock = clock;
     _scrubber = [[MDMTimelineScrubber alloc] initWithTimeline:self];
 
     _observers = [NSHashTable weakObjectsHashTable];
+    _curveTable = [MDMSampledCurveTable new];
   }
   return self;
 }
 
+- (void)dealloc {
+  if (_scrubDelivery == MDMTimelineScrubDeliveryClock) {
+    [_clock removeClockObserver:self];
+  }
+}
+
 #pragma mark - Public
 
 - (void)begin {
   NSAssert(_beginTime == nil, @"Begin was already invoked on this timeline.");
-  _beginTime = @(CACurrentMediaTime());
+  _beginTime = @(_clock.currentTime);
 }
 
 - (void)attachScrubberWithTimeOffset:(NSTimeInterval)timeOffset {
@@ -87,6 +111,7 @@
     return;
   }
   _isScrubberAttached = false;
+  _hasPendingScrub = NO;
 
   for (id<MDMTimelineObserving> observer in _observers) {
     [observer timeline:self didDetachScrubber:_scrubber];
@@ -99,19 +124,111 @@
 
 - (void)addTimelineObserver:(id<MDMTimelineObserving>)observer {
   [_observers addObject:observer];
+  _observerSnapshot = nil;
 }
 
 - (void)removeTimelineObserver:(nonnull id<MDMTimelineObserving>)observer {
   [_observers removeObject:observer];
+  _observerSnapshot = nil;
+}
+
+- (void)setScrubDelivery:(MDMTimelineScrubDelivery)scrubDelivery {
+  if (_scrubDelivery == scrubDelivery) {
+    return;
+  }
+  _scrubDelivery = scrubDelivery;
+
+  switch (scrubDelivery) {
+    case MDMTimelineScrubDeliveryImmediate:
+      [_clock removeClockObserver:self];
+      [self deliverPendingScrub];
+      break;
+    case MDMTimelineScrubDeliveryClock:
+      [_clock addClockObserver:self];
+      break;
+  }
+}
+
+- (void)addCurve:(MDMTimelineCurve)curve
+        duration:(NSTimeInterval)duration
+       forTarget:(id)target
+         applier:(MDMTimelineCurveApplier)applier {
+  [_curveTable addCurve:curve duration:duration forTarget:target applier:applier];
+}
+
+- (void)removeCurvesForTarget:(id)target {
+  [_curveTable removeCurvesForTarget:target];
+}
+
+- (double)curveSampleRate {
+  return _curveTable.sampleRate;
+}
+
+- (void)setCurveSampleRate:(double)curveSampleRate {
+  _curveTable.sampleRate = curveSampleRate;
+}
+
+- (NSUInteger)curveCount {
+  return _curveTable.count;
+}
+
+#pragma mark - MDMTargetPlanObserving
+
+- (void)plansDidChangeForTarget:(id)target {
+  [_curveTable invalidateCurvesForTarget:target];
 }
 
+#pragma mark - MDMClockObserving
+
+- (void)clockDidTick:(id<MDMClock>)clock {
+  [self deliverPendingScrub];
+}
+
+#pragma mark - Private
+
 - (void)scrubberDidScrub:(NSTimeInterval)timeOffset {
   if (!_isScrubberAttached) {
     return;
   }
+  if (_scrubDelivery == MDMTimelineScrubDeliveryClock) {
+    _pendingTimeOffset = timeOffset;
+    _hasPendingScrub = YES;
+    return;
+  }
+  [_curveTable applyValuesAtTimeOffset:timeOffset];
   for (id<MDMTimelineObserving> observer in _observers) {
     [observer timeline:self scrubberDidScrub:timeOffset];
   }
 }
 
+- (void)deliverPendingScrub {
+  if (!_hasPendingScrub) {
+    return;
+  }
+  _hasPendingScrub = NO;
+  NSTimeInterval timeOffset = _pendingTimeOffset;
+  [_curveTable applyValuesAtTimeOffset:timeOffset];
+
+  if (!_observerSnapshot) {
+    _observerSnapshot = [NSPointerArray weakObjectsPointerArray];
+    for (id<MDMTimelineObserving> observer in _observers) {
+      [_observerSnapshot addPointer:(__bridge void *)observer];
+    }
+  }
+
+  // Observers may add or remove observers, which replaces the snapshot.
+  NSPointerArray *observers = _observerSnapshot;
+  NSUInteger count = observers.count;
+  for (NSUInteger ix = 0; ix < count; ix++) {
+    id<MDMTimelineObserving> observer =
+        (__bridge id<MDMTimelineObserving>)[observers pointerAtIndex:ix];
+    if (!observer) {
+      // The observer was deallocated. Rebuild the snapshot on the next delivery.
+      _observerSnapshot = nil;
+      continue;
+    }
+    [observer timeline:self scrubberDidScrub:timeOffset];
+  }
+}
+
 @end
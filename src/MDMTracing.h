@@ -32,6 +32,15 @@ NS_SWIFT_NAME(Tracing)
 - (void)didAddPlan:(nonnull id<MDMPlan>)plan to:(nonnull id)target
     NS_SWIFT_NAME(didAddPlan(_:to:));
 
+/**
+ Invoked once after a batch of plans has been added to the runtime with addPlans:to:.
+
+ Tracers that do not implement this method will instead receive one didAddPlan:to: invocation per
+ plan in the batch.
+ */
+- (void)didAddPlans:(nonnull NSArray<id<MDMPlan>> *)plans to:(nonnull id)target
+    NS_SWIFT_NAME(didAddPlans(_:to:));
+
 /** Invoked after a named plan has been added to the runtime. */
 - (void)didAddPlan:(nonnull id<MDMNamedPlan>)plan named:(nonnull NSString *)name to:(nonnull id)target
     NS_SWIFT_NAME(didAddPlan(_:named:to:));
@@ -44,4 +53,13 @@ NS_SWIFT_NAME(Tracing)
 - (void)didCreatePerformer:(nonnull id<MDMPerforming>)performer for:(nonnull id)target
     NS_SWIFT_NAME(didCreatePerformer(_:for:));
 
+/**
+ Invoked when a plan emitted by a composable performer is discarded because it exceeded the
+ runtime's emission depth or emitted plan count limit.
+
+ A dropped plan usually indicates an emission cycle.
+ */
+- (void)didDropEmittedPlan:(nonnull id<MDMPlan>)plan to:(nonnull id)target
+    NS_SWIFT_NAME(didDropEmittedPlan(_:to:));
+
 @end
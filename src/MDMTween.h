@@ -0,0 +1,72 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMPlan.h"
+
+/** The pacing of a tween's progress over its duration. */
+typedef NS_ENUM(NSInteger, MDMTweenTimingFunction) {
+  /** Progress is proportional to elapsed time. */
+  MDMTweenTimingFunctionLinear,
+
+  /** Progress accelerates from rest and decelerates to rest following a smoothstep curve. */
+  MDMTweenTimingFunctionEaseInOut,
+} NS_SWIFT_NAME(TweenTimingFunction);
+
+/**
+ Moves the numeric value at a key path of the target from one value to another over a duration.
+
+ Tweens are advanced by the runtime's built-in motion solver on every tick of the runtime's
+ frameClock, together with every other active spring and tween of the runtime. The tween's token is
+ active until its duration has elapsed.
+
+ Adding a tween for a key path that is already animating replaces the existing motion.
+ */
+NS_SWIFT_NAME(Tween)
+@interface MDMTween : NSObject <MDMNamedPlan, MDMImmutablePlan>
+
+/** Initializes a tween with MDMTweenTimingFunctionEaseInOut timing. */
+- (nonnull instancetype)initWithKeyPath:(nonnull NSString *)keyPath
+                                   from:(double)from
+                                     to:(double)to
+                               duration:(NSTimeInterval)duration;
+
+- (nonnull instancetype)initWithKeyPath:(nonnull NSString *)keyPath
+                                   from:(double)from
+                                     to:(double)to
+                               duration:(NSTimeInterval)duration
+                         timingFunction:(MDMTweenTimingFunction)timingFunction
+    NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/** The key path of the target's value. The value must be a number. */
+@property(nonatomic, copy, nonnull, readonly) NSString *keyPath;
+
+/** The value at the start of the tween. */
+@property(nonatomic, assign, readonly) double from;
+
+/** The value at the end of the tween. */
+@property(nonatomic, assign, readonly) double to;
+
+/** The time it takes to move from one value to the other. */
+@property(nonatomic, assign, readonly) NSTimeInterval duration;
+
+@property(nonatomic, assign, readonly) MDMTweenTimingFunction timingFunction;
+
+@end
@@ -0,0 +1,61 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMTween.h"
+
+#import "private/MDMMotionSolverPerformer.h"
+
+@implementation MDMTween
+
+- (instancetype)initWithKeyPath:(NSString *)keyPath
+                           from:(double)from
+                             to:(double)to
+                       duration:(NSTimeInterval)duration {
+  return [self initWithKeyPath:keyPath
+                          from:from
+                            to:to
+                      duration:duration
+                timingFunction:MDMTweenTimingFunctionEaseInOut];
+}
+
+- (instancetype)initWithKeyPath:(NSString *)keyPath
+                           from:(double)from
+                             to:(double)to
+                       duration:(NSTimeInterval)duration
+                 timingFunction:(MDMTweenTimingFunction)timingFunction {
+  NSParameterAssert(duration >= 0);
+  self = [super init];
+  if (self) {
+    _keyPath = [keyPath copy];
+    _from = from;
+    _to = to;
+    _duration = duration;
+    _timingFunction = timingFunction;
+  }
+  return self;
+}
+
+#pragma mark - MDMPlan
+
+- (Class)performerClass {
+  return [MDMMotionSolverPerformer class];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  return self;
+}
+
+@end
@@ -0,0 +1,45 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMClock.h"
+
+/**
+ A virtual clock only moves when it is explicitly advanced.
+
+ Each advance produces one tick. Virtual clocks make time-driven behavior deterministic in tests and
+ allow simulations to run faster than real time.
+ */
+NS_SWIFT_NAME(VirtualClock)
+@interface MDMVirtualClock : NSObject <MDMClock>
+
+/** Advances the clock's current time by the given non-negative interval and then ticks. */
+- (void)advanceBy:(NSTimeInterval)interval
+    NS_SWIFT_NAME(advance(by:));
+
+/**
+ Advances the clock's current time by the given non-negative interval, ticking after every step.
+
+ Fast-forwards time-driven behavior as if frames of the given positive duration had elapsed. The
+ last step is shortened so that the clock ends exactly interval later. Step times are computed from
+ the starting time rather than accumulated, so long fast-forwards don't drift. Does not tick if the
+ interval is 0.
+ */
+- (void)advanceBy:(NSTimeInterval)interval inStepsOf:(NSTimeInterval)step
+    NS_SWIFT_NAME(advance(by:inStepsOf:));
+
+@end
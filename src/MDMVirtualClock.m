@@ -0,0 +1,74 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMVirtualClock.h"
+
+#import <math.h>
+
+@implementation MDMVirtualClock {
+  NSHashTable<id<MDMClockObserving>> *_observers;
+}
+
+@synthesize currentTime = _currentTime;
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _observers = [NSHashTable weakObjectsHashTable];
+  }
+  return self;
+}
+
+- (void)advanceBy:(NSTimeInterval)interval {
+  NSParameterAssert(interval >= 0);
+  _currentTime += interval;
+  [self tick];
+}
+
+- (void)advanceBy:(NSTimeInterval)interval inStepsOf:(NSTimeInterval)step {
+  NSParameterAssert(interval >= 0);
+  NSParameterAssert(step > 0);
+  NSTimeInterval startTime = _currentTime;
+  NSTimeInterval endTime = startTime + interval;
+  // Tolerates rounding error so that a whole number of steps doesn't gain an almost empty step.
+  double steps = interval / step;
+  NSUInteger stepCount = (NSUInteger)ceil(steps - steps * 1e-9);
+  for (NSUInteger ix = 1; ix <= stepCount; ix++) {
+    _currentTime = ix == stepCount ? endTime : startTime + (NSTimeInterval)ix * step;
+    [self tick];
+  }
+}
+
+#pragma mark - Private
+
+- (void)tick {
+  // Observers may add or remove observers in response to a tick.
+  for (id<MDMClockObserving> observer in _observers.allObjects) {
+    [observer clockDidTick:self];
+  }
+}
+
+#pragma mark - MDMClock
+
+- (void)addClockObserver:(id<MDMClockObserving>)observer {
+  [_observers addObject:observer];
+}
+
+- (void)removeClockObserver:(id<MDMClockObserving>)observer {
+  [_observers removeObject:observer];
+}
+
+@end
@@ -14,9 +14,19 @@
  limitations under the License.
  */
 
+#import "MDMBinaryTraceRecorder.h"
+#import "MDMClock.h"
 #import "MDMConsoleLoggingTracer.h"
+#import "MDMCopyOnWritePlan.h"
+#import "MDMMonotonicClock.h"
 #import "MDMMotionRuntime.h"
+#import "MDMPerformerLatencyRecorder.h"
 #import "MDMPerforming.h"
 #import "MDMPlan.h"
+#import "MDMPlanName.h"
+#import "MDMRuntimeSnapshot.h"
+#import "MDMSpring.h"
 #import "MDMTimeline.h"
 #import "MDMTracing.h"
+#import "MDMTween.h"
+#import "MDMVirtualClock.h"
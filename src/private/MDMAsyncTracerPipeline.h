@@ -0,0 +1,93 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/** The MDMTracing events that can be carried by an MDMTraceRecord. */
+typedef NS_ENUM(uint8_t, MDMTraceEventType) {
+  MDMTraceEventTypeDidAddPlan,
+  MDMTraceEventTypeDidAddPlans,
+  MDMTraceEventTypeDidAddPlanNamed,
+  MDMTraceEventTypeDidRemovePlanNamed,
+  MDMTraceEventTypeDidCreatePerformer,
+  MDMTraceEventTypeDidDropEmittedPlan,
+};
+
+/**
+ A compact fixed-size trace event.
+
+ The object pointers are retained while the record sits in the pipeline and are released on the
+ producer's thread once the record has been delivered. object is the plan, array of plans or
+ performer, depending on the event type.
+ */
+typedef struct {
+  MDMTraceEventType type;
+  const void *_Nullable object;
+  const void *_Nullable target;
+  const void *_Nullable name;
+} MDMTraceRecord;
+
+/** An object that receives trace records on the pipeline's background thread. */
+@protocol MDMTraceRecordDelivering <NSObject>
+
+- (void)deliverTraceRecord:(nonnull const MDMTraceRecord *)record;
+
+@end
+
+/**
+ A lock-free single-producer ring buffer of trace records that is drained by a background thread.
+
+ All enqueue, flush and stop invocations must be made from the same thread. Enqueueing does not
+ allocate memory. When the ring buffer is full the event is dropped and counted.
+
+ The consumer never releases a record's objects. Delivered records are handed back to the producer,
+ which releases them on its next enqueue, flush or stop.
+ */
+@interface MDMAsyncTracerPipeline : NSObject
+
+/**
+ Starts a background thread that delivers records to the given deliverer.
+
+ @param capacity The number of records the ring buffer can hold. Rounded up to a power of two.
+ */
+- (nonnull instancetype)initWithCapacity:(NSUInteger)capacity
+                               deliverer:(nonnull id<MDMTraceRecordDelivering>)deliverer
+    NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/**
+ Enqueues an event.
+
+ The provided objects are retained until the event has been delivered and are then released on this
+ thread.
+ */
+- (void)enqueueEventOfType:(MDMTraceEventType)type
+                    object:(nullable id)object
+                    target:(nullable id)target
+                      name:(nullable NSString *)name;
+
+/** Blocks until every event enqueued so far has been delivered. */
+- (void)flush;
+
+/** Delivers all outstanding events and stops the background thread. */
+- (void)stop;
+
+/** The number of events that were dropped because the ring buffer was full. */
+@property(nonatomic, assign, readonly) NSUInteger droppedEventCount;
+
+@end
@@ -0,0 +1,186 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMAsyncTracerPipeline.h"
+
+#import <stdatomic.h>
+#import <stdlib.h>
+
+typedef struct {
+  // The producer and the consumer each own one index. They are kept on separate cache lines.
+  _Atomic(uint64_t) head;
+  char padding[64 - sizeof(_Atomic(uint64_t))];
+  _Atomic(uint64_t) tail;
+  _Atomic(uint64_t) dropped;
+  _Atomic(bool) stopping;
+  // Owned by the producer. Records in [released, tail) have been delivered but still hold their
+  // objects; the producer releases them so that the objects are never deallocated by the consumer.
+  uint64_t released;
+  uint64_t mask;
+  MDMTraceRecord records[];
+} MDMTraceRing;
+
+static void releaseTraceRecord(const MDMTraceRecord *record) {
+  if (record->object) {
+    CFRelease(record->object);
+  }
+  if (record->target) {
+    CFRelease(record->target);
+  }
+  if (record->name) {
+    CFRelease(record->name);
+  }
+}
+
+@implementation MDMAsyncTracerPipeline {
+  MDMTraceRing *_ring;
+  __weak id<MDMTraceRecordDelivering> _deliverer;
+
+  NSThread *_thread;
+  dispatch_semaphore_t _recordsAvailable;
+  dispatch_semaphore_t _threadExited;
+  NSCondition *_drainCondition;
+  BOOL _stopped;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+                       deliverer:(id<MDMTraceRecordDelivering>)deliverer {
+  self = [super init];
+  if (self) {
+    uint64_t roundedCapacity = 1;
+    while (roundedCapacity < capacity) {
+      roundedCapacity <<= 1;
+    }
+    _ring = calloc(1, sizeof(MDMTraceRing) + roundedCapacity * sizeof(MDMTraceRecord));
+    _ring->mask = roundedCapacity - 1;
+    _deliverer = deliverer;
+
+    _recordsAvailable = dispatch_semaphore_create(0);
+    _threadExited = dispatch_semaphore_create(0);
+    _drainCondition = [NSCondition new];
+
+    _thread = [[NSThread alloc] initWithTarget:self selector:@selector(drainLoop) object:nil];
+    _thread.name = @"com.material-motion.runtime.tracing";
+    [_thread start];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  // The background thread retains the pipeline until it has stopped, so every record has been
+  // delivered by now.
+  [self releaseDeliveredRecords];
+  free(_ring);
+}
+
+#pragma mark - Producer
+
+- (void)enqueueEventOfType:(MDMTraceEventType)type
+                    object:(id)object
+                    target:(id)target
+                      name:(NSString *)name {
+  [self releaseDeliveredRecords];
+
+  uint64_t head = atomic_load_explicit(&_ring->head, memory_order_relaxed);
+  if (head - _ring->released > _ring->mask) {
+    atomic_fetch_add_explicit(&_ring->dropped, 1, memory_order_relaxed);
+    return;
+  }
+
+  MDMTraceRecord *record = &_ring->records[head & _ring->mask];
+  record->type = type;
+  record->object = object ? CFBridgingRetain(object) : NULL;
+  record->target = target ? CFBridgingRetain(target) : NULL;
+  record->name = name ? CFBridgingRetain(name) : NULL;
+
+  atomic_store_explicit(&_ring->head, head + 1, memory_order_release);
+  dispatch_semaphore_signal(_recordsAvailable);
+}
+
+- (void)flush {
+  uint64_t head = atomic_load_explicit(&_ring->head, memory_order_relaxed);
+  [_drainCondition lock];
+  while (atomic_load_explicit(&_ring->tail, memory_order_acquire) < head) {
+    [_drainCondition wait];
+  }
+  [_drainCondition unlock];
+
+  [self releaseDeliveredRecords];
+}
+
+- (void)stop {
+  if (_stopped) {
+    return;
+  }
+  _stopped = YES;
+  atomic_store_explicit(&_ring->stopping, true, memory_order_release);
+  dispatch_semaphore_signal(_recordsAvailable);
+  dispatch_semaphore_wait(_threadExited, DISPATCH_TIME_FOREVER);
+  _thread = nil;
+
+  [self releaseDeliveredRecords];
+}
+
+- (NSUInteger)droppedEventCount {
+  return (NSUInteger)atomic_load_explicit(&_ring->dropped, memory_order_relaxed);
+}
+
+// Releases the objects of every record the consumer has finished with. Must only be invoked on the
+// producer's thread so that targets such as views and layers are deallocated where they were used.
+- (void)releaseDeliveredRecords {
+  uint64_t tail = atomic_load_explicit(&_ring->tail, memory_order_acquire);
+  while (_ring->released < tail) {
+    releaseTraceRecord(&_ring->records[_ring->released & _ring->mask]);
+    _ring->released++;
+  }
+}
+
+#pragma mark - Consumer
+
+- (void)drainLoop {
+  while (YES) {
+    dispatch_semaphore_wait(_recordsAvailable, DISPATCH_TIME_FOREVER);
+    // Read the stop flag before draining so that every record enqueued before stop is delivered.
+    BOOL stopping = atomic_load_explicit(&_ring->stopping, memory_order_acquire);
+
+    @autoreleasepool {
+      [self drainAvailableRecords];
+    }
+
+    if (stopping) {
+      break;
+    }
+  }
+  dispatch_semaphore_signal(_threadExited);
+}
+
+- (void)drainAvailableRecords {
+  id<MDMTraceRecordDelivering> deliverer = _deliverer;
+  uint64_t tail = atomic_load_explicit(&_ring->tail, memory_order_relaxed);
+  uint64_t head = atomic_load_explicit(&_ring->head, memory_order_acquire);
+  while (tail < head) {
+    MDMTraceRecord *record = &_ring->records[tail & _ring->mask];
+    [deliverer deliverTraceRecord:record];
+    tail++;
+    atomic_store_explicit(&_ring->tail, tail, memory_order_release);
+  }
+
+  [_drainCondition lock];
+  [_drainCondition broadcast];
+  [_drainCondition unlock];
+}
+
+@end
@@ -0,0 +1,98 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+/*
+ The on-disk layout written by MDMBinaryTraceRecorder.
+
+ This header is plain C so that offline tools can read captures without Foundation. All values are
+ stored in the byte order of the recording device.
+
+ A capture file consists of:
+
+ 1. One MDMBinaryTraceHeader.
+ 2. recordCapacity MDMBinaryTraceRecord entries, used as a ring buffer. The record for event n is
+    stored at index n % recordCapacity; recordsWritten is the total number of events recorded.
+ 3. A string table of stringTableCapacity bytes, of which stringTableLength are in use. The table is
+    a sequence of MDMBinaryTraceString entries, each followed by its UTF-8 bytes padded to a
+    multiple of four bytes.
+ */
+
+#include <stdint.h>
+
+#define MDM_BINARY_TRACE_MAGIC 0x54444d4du  // "MMDT" in little-endian
+#define MDM_BINARY_TRACE_VERSION 2u
+
+/** Identifies the MDMTracing event that produced a record. */
+typedef enum {
+  MDMBinaryTraceEventDidAddPlan = 1,
+  MDMBinaryTraceEventDidAddPlanNamed = 2,
+  MDMBinaryTraceEventDidRemovePlanNamed = 3,
+  MDMBinaryTraceEventDidCreatePerformer = 4,
+  MDMBinaryTraceEventDidDropEmittedPlan = 5,
+} MDMBinaryTraceEvent;
+
+/** Identifies what an interned string describes. */
+typedef enum {
+  /** The name of a plan or performer class. */
+  MDMBinaryTraceStringKindClass = 1,
+
+  /** The name of a named plan. */
+  MDMBinaryTraceStringKindPlanName = 2,
+} MDMBinaryTraceStringKind;
+
+/** The flags stored in MDMBinaryTraceHeader.flags. */
+enum {
+  /** Set when a string did not fit in the string table. Records may reference unknown IDs. */
+  MDMBinaryTraceFlagStringTableOverflow = 1u << 0,
+};
+
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t headerSize;
+  uint32_t recordSize;
+  uint32_t recordCapacity;
+  uint32_t stringTableCapacity;
+  uint32_t stringTableLength;
+  uint32_t flags;
+  uint32_t reserved;
+  uint64_t recordsWritten;
+  /** The monotonic timestamp at which recording began, in nanoseconds. */
+  uint64_t startTimestamp;
+} MDMBinaryTraceHeader;
+
+typedef struct {
+  /** Monotonic timestamp in nanoseconds. */
+  uint64_t timestamp;
+  uint16_t event;
+  uint16_t reserved;
+  /** Identifies the target. Targets are numbered from 1 in order of first appearance. */
+  uint32_t targetID;
+  /** Interned plan class name ID, or 0. */
+  uint32_t planClassID;
+  /** Interned performer class name ID, or 0. */
+  uint32_t performerClassID;
+  /** Interned plan name ID, or 0. */
+  uint32_t nameID;
+  /** Interned target class name ID. */
+  uint32_t targetClassID;
+} MDMBinaryTraceRecord;
+
+typedef struct {
+  uint32_t identifier;
+  uint16_t kind;
+  uint16_t length;
+} MDMBinaryTraceString;
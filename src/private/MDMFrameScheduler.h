@@ -0,0 +1,42 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMClock.h"
+#import "MDMPerforming.h"
+
+/**
+ Steps every scheduled stepper once per tick of its clock.
+
+ Steppers are grouped by class so that each group is stepped in one loop through a cached method
+ implementation. Steppers that report rest are unscheduled and their tokens are deactivated once
+ every group has been stepped.
+ */
+@interface MDMFrameScheduler : NSObject <MDMFrameScheduling, MDMClockObserving>
+
+/**
+ The clock whose ticks advance the scheduled steppers.
+
+ Steppers remain scheduled but are not stepped while the clock is nil. Setting a clock resets the
+ time of the previous tick to the clock's current time.
+ */
+@property(nonatomic, strong, nullable) id<MDMClock> clock;
+
+/** The number of steppers that are currently scheduled. */
+@property(nonatomic, assign, readonly) NSUInteger scheduledStepperCount;
+
+@end
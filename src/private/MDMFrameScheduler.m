@@ -0,0 +1,222 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMFrameScheduler.h"
+
+#import <objc/runtime.h>
+
+typedef BOOL (*MDMStepIMP)(id, SEL, NSTimeInterval);
+
+@class MDMFrameStepperGroup;
+
+/** A scheduled stepper and the token that is active while it is scheduled. */
+@interface MDMScheduledStepper : NSObject
+@end
+
+@implementation MDMScheduledStepper {
+ @package
+  id<MDMFrameStepping> _stepper;
+  id<MDMTokened> _token;
+  __unsafe_unretained MDMFrameStepperGroup *_group;
+  // The index of the record in its group's records.
+  NSUInteger _index;
+  // Cleared when the stepper is unscheduled during a tick. The record is compacted afterwards.
+  BOOL _scheduled;
+}
+@end
+
+/** The scheduled steppers of a single class. */
+@interface MDMFrameStepperGroup : NSObject
+@end
+
+@implementation MDMFrameStepperGroup {
+ @package
+  MDMStepIMP _step;
+  NSMutableArray<MDMScheduledStepper *> *_records;
+}
+@end
+
+@implementation MDMFrameScheduler {
+  // Groups in the order in which their classes were first scheduled.
+  NSMutableArray<MDMFrameStepperGroup *> *_groups;
+  NSMapTable<Class, MDMFrameStepperGroup *> *_classToGroup;
+  NSMapTable<id<MDMFrameStepping>, MDMScheduledStepper *> *_stepperToRecord;
+
+  NSTimeInterval _lastTickTime;
+  BOOL _ticking;
+  BOOL _needsCompaction;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _groups = [NSMutableArray array];
+    _classToGroup =
+        [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsOpaqueMemory
+                                                | NSPointerFunctionsOpaquePersonality)
+                                  valueOptions:NSPointerFunctionsStrongMemory
+                                      capacity:0];
+    _stepperToRecord =
+        [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsStrongMemory
+                                                | NSPointerFunctionsObjectPointerPersonality)
+                                  valueOptions:NSPointerFunctionsStrongMemory
+                                      capacity:0];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [_clock removeClockObserver:self];
+}
+
+- (void)setClock:(id<MDMClock>)clock {
+  if (_clock == clock) {
+    return;
+  }
+  [_clock removeClockObserver:self];
+  _clock = clock;
+  _lastTickTime = clock.currentTime;
+  [_clock addClockObserver:self];
+}
+
+- (NSUInteger)scheduledStepperCount {
+  return _stepperToRecord.count;
+}
+
+#pragma mark - MDMFrameScheduling
+
+- (void)scheduleStepper:(id<MDMFrameStepping>)stepper token:(id<MDMTokened>)token {
+  if ([_stepperToRecord objectForKey:stepper]) {
+    return;
+  }
+  Class stepperClass = object_getClass(stepper);
+  MDMFrameStepperGroup *group = [_classToGroup objectForKey:stepperClass];
+  if (!group) {
+    group = [MDMFrameStepperGroup new];
+    SEL selector = @selector(stepByTimeInterval:);
+    group->_step = (MDMStepIMP)[stepperClass instanceMethodForSelector:selector];
+    group->_records = [NSMutableArray array];
+    [_classToGroup setObject:group forKey:stepperClass];
+    [_groups addObject:group];
+  }
+
+  MDMScheduledStepper *record = [MDMScheduledStepper new];
+  record->_stepper = stepper;
+  record->_token = token;
+  record->_group = group;
+  record->_index = group->_records.count;
+  record->_scheduled = YES;
+  [group->_records addObject:record];
+  [_stepperToRecord setObject:record forKey:stepper];
+
+  token.active = YES;
+}
+
+- (void)unscheduleStepper:(id<MDMFrameStepping>)stepper {
+  MDMScheduledStepper *record = [_stepperToRecord objectForKey:stepper];
+  if (!record) {
+    return;
+  }
+  [self removeRecord:record];
+  record->_token.active = NO;
+}
+
+#pragma mark - MDMClockObserving
+
+- (void)clockDidTick:(id<MDMClock>)clock {
+  NSTimeInterval now = clock.currentTime;
+  NSTimeInterval interval = now - _lastTickTime;
+  _lastTickTime = now;
+  if (_stepperToRecord.count == 0) {
+    return;
+  }
+
+  SEL selector = @selector(stepByTimeInterval:);
+  NSMutableArray<id<MDMTokened>> *restingTokens = nil;
+
+  // Steppers and groups scheduled during the tick are first stepped on the next tick.
+  _ticking = YES;
+  NSUInteger groupCount = _groups.count;
+  for (NSUInteger groupIndex = 0; groupIndex < groupCount; groupIndex++) {
+    MDMFrameStepperGroup *group = _groups[groupIndex];
+    MDMStepIMP step = group->_step;
+    NSUInteger recordCount = group->_records.count;
+    for (NSUInteger index = 0; index < recordCount; index++) {
+      MDMScheduledStepper *record = group->_records[index];
+      if (!record->_scheduled) {
+        continue;
+      }
+      if (!step(record->_stepper, selector, interval) || !record->_scheduled) {
+        continue;
+      }
+      [self removeRecord:record];
+      if (record->_token) {
+        if (!restingTokens) {
+          restingTokens = [NSMutableArray array];
+        }
+        [restingTokens addObject:record->_token];
+      }
+    }
+  }
+  _ticking = NO;
+
+  if (_needsCompaction) {
+    [self compactGroups];
+  }
+
+  // Deactivating a token can inform the runtime's delegate, which may schedule new steppers.
+  for (id<MDMTokened> token in restingTokens) {
+    token.active = NO;
+  }
+}
+
+#pragma mark - Private
+
+- (void)removeRecord:(MDMScheduledStepper *)record {
+  [_stepperToRecord removeObjectForKey:record->_stepper];
+  record->_scheduled = NO;
+  if (_ticking) {
+    // Indices must stay stable while the groups are being stepped.
+    _needsCompaction = YES;
+    return;
+  }
+
+  // Swap the last record into the removed record's place.
+  NSMutableArray<MDMScheduledStepper *> *records = record->_group->_records;
+  MDMScheduledStepper *last = records.lastObject;
+  records[record->_index] = last;
+  last->_index = record->_index;
+  [records removeLastObject];
+}
+
+- (void)compactGroups {
+  for (MDMFrameStepperGroup *group in _groups) {
+    NSMutableArray<MDMScheduledStepper *> *records = group->_records;
+    NSUInteger count = 0;
+    for (NSUInteger index = 0; index < records.count; index++) {
+      MDMScheduledStepper *record = records[index];
+      if (record->_scheduled) {
+        record->_index = count;
+        records[count] = record;
+        count++;
+      }
+    }
+    [records removeObjectsInRange:NSMakeRange(count, records.count - count)];
+  }
+  _needsCompaction = NO;
+}
+
+@end
@@ -0,0 +1,29 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMMotionRuntime.h"
+
+@interface MDMMotionRuntime ()
+
+/**
+ Adds a plan emitted by a composable performer.
+
+ Emitted plans are queued and added once the outermost plan addition in progress completes. If no
+ addition is in progress the plan is added immediately.
+ */
+- (void)emitPlan:(nonnull NSObject<MDMPlan> *)plan to:(nonnull id)target;
+
+@end
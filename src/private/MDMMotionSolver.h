@@ -0,0 +1,110 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMPerforming.h"
+
+@class MDMFrameScheduler;
+@class MDMSpring;
+@class MDMTween;
+
+/**
+ The numeric value at one key path of one target.
+
+ A channel is driven by at most one spring or tween at a time. Values of double and float
+ properties are written by calling the property's setter directly. Other key paths are written with
+ key-value coding.
+ */
+@interface MDMMotionSolverChannel : NSObject
+
+- (nonnull instancetype)initWithTarget:(nonnull id)target
+                               keyPath:(nonnull NSString *)keyPath NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+@property(nonatomic, weak, nullable, readonly) id target;
+@property(nonatomic, copy, nonnull, readonly) NSString *keyPath;
+
+/** Whether a spring or tween is currently driving the channel. */
+@property(nonatomic, assign, readonly, getter=isAnimating) BOOL animating;
+
+@end
+
+/**
+ Integrates every active spring and tween of a runtime in struct-of-arrays form.
+
+ The solver schedules itself with the runtime's frame scheduler while any motion is active. Each
+ step integrates all springs and then all tweens with the kernels in MDMMotionSolverKernels.h,
+ writes the new values to the channels' targets and deactivates the tokens of motions that have
+ come to rest.
+ */
+@interface MDMMotionSolver : NSObject <MDMFrameStepping>
+
+- (nonnull instancetype)initWithFrameScheduler:(nonnull MDMFrameScheduler *)frameScheduler
+    NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/**
+ Drives the channel with the spring and activates the token.
+
+ A spring that is already driving the channel is retargeted and keeps its position and velocity. A
+ tween that is driving the channel is replaced by the spring, starting from the tween's current
+ value. Otherwise the spring starts at rest from the channel's current value. The token of the
+ channel's previous motion, if any, is deactivated.
+ */
+- (void)animateChannel:(nonnull MDMMotionSolverChannel *)channel
+            withSpring:(nonnull MDMSpring *)spring
+                 token:(nullable id<MDMTokened>)token;
+
+/**
+ Retargets the spring that is driving the channel without changing its position, velocity or token.
+
+ @return NO if the channel is not driven by a spring, in which case nothing changes.
+ */
+- (BOOL)retargetChannel:(nonnull MDMMotionSolverChannel *)channel
+             withSpring:(nonnull MDMSpring *)spring;
+
+/**
+ Drives the channel with the tween and activates the token.
+
+ Any motion that is driving the channel is replaced and its token is deactivated.
+ */
+- (void)animateChannel:(nonnull MDMMotionSolverChannel *)channel
+             withTween:(nonnull MDMTween *)tween
+                 token:(nullable id<MDMTokened>)token;
+
+/** Stops any motion driving the channel and deactivates its token. The value is left as is. */
+- (void)stopChannel:(nonnull MDMMotionSolverChannel *)channel;
+
+/** The number of springs that are not at rest. */
+@property(nonatomic, assign, readonly) NSUInteger activeSpringCount;
+
+/** The number of tweens whose duration has not elapsed. */
+@property(nonatomic, assign, readonly) NSUInteger activeTweenCount;
+
+@end
+
+/** A performer conforming to MDMMotionSolverPerforming animates its target with a motion solver. */
+@protocol MDMMotionSolverPerforming <MDMContinuousPerforming>
+
+/** Provides the performer with its runtime's motion solver before any plans are added. */
+- (void)setMotionSolver:(nonnull MDMMotionSolver *)motionSolver;
+
+@end
@@ -0,0 +1,456 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMMotionSolver.h"
+
+#import <float.h>
+#import <math.h>
+#import <objc/runtime.h>
+#import <stdlib.h>
+#import <string.h>
+
+#import "MDMFrameScheduler.h"
+#import "MDMMotionSolverKernels.h"
+#import "MDMSpring.h"
+#import "MDMTween.h"
+
+// The longest interval integrated by one spring kernel pass. Longer frames are split into substeps.
+static const NSTimeInterval kMaxSpringStep = 1.0 / 240.0;
+
+// Bounds the cost of a very long frame, such as the first frame after a stall.
+static const NSUInteger kMaxSpringSubsteps = 16;
+
+// The distance and speed below which a spring is at rest.
+static const double kSpringRestThreshold = 0.001;
+
+// The position must be the first field of both kinds of motion.
+enum {
+  kSpringPosition,
+  kSpringVelocity,
+  kSpringDestination,
+  kSpringStiffness,
+  kSpringDamping,
+  kSpringFieldCount,
+};
+
+enum {
+  kTweenPosition,
+  kTweenElapsed,
+  kTweenFrom,
+  kTweenTo,
+  kTweenDuration,
+  kTweenEasing,
+  kTweenFieldCount,
+};
+
+typedef NS_ENUM(NSInteger, MDMChannelMotion) {
+  MDMChannelMotionNone,
+  MDMChannelMotionSpring,
+  MDMChannelMotionTween,
+};
+
+@implementation MDMMotionSolverChannel {
+ @package
+  MDMChannelMotion _motion;
+  // The index of the channel's motion in the solver's arrays of its kind.
+  NSUInteger _index;
+  id<MDMTokened> _token;
+
+  // The setter of the key path's property. NULL if the key path has more than one component.
+  SEL _setter;
+  // The class the setter was resolved for. Observing a target with KVO changes its class.
+  Class _setterClass;
+  IMP _setterIMP;
+  // The setter's argument type encoding, or 0 if values must be set with key-value coding.
+  char _setterType;
+}
+
+- (instancetype)initWithTarget:(id)target keyPath:(NSString *)keyPath {
+  self = [super init];
+  if (self) {
+    _target = target;
+    _keyPath = [keyPath copy];
+    _index = NSNotFound;
+    if (_keyPath.length > 0 && [_keyPath rangeOfString:@"."].location == NSNotFound) {
+      NSString *setterName =
+          [NSString stringWithFormat:@"set%@%@:", [_keyPath substringToIndex:1].uppercaseString,
+                                     [_keyPath substringFromIndex:1]];
+      _setter = NSSelectorFromString(setterName);
+    }
+  }
+  return self;
+}
+
+- (BOOL)isAnimating {
+  return _motion != MDMChannelMotionNone;
+}
+
+@end
+
+static void resolveSetter(MDMMotionSolverChannel *channel, Class targetClass) {
+  channel->_setterClass = targetClass;
+  channel->_setterIMP = NULL;
+  channel->_setterType = 0;
+  Method method = channel->_setter ? class_getInstanceMethod(targetClass, channel->_setter) : NULL;
+  if (!method || method_getNumberOfArguments(method) != 3) {
+    return;
+  }
+  char *argumentType = method_copyArgumentType(method, 2);
+  if (argumentType && (strcmp(argumentType, @encode(double)) == 0
+                       || strcmp(argumentType, @encode(float)) == 0)) {
+    channel->_setterIMP = method_getImplementation(method);
+    channel->_setterType = argumentType[0];
+  }
+  free(argumentType);
+}
+
+// Calls the setter of double and float properties directly. Other values are set with key-value
+// coding.
+static void setChannelValue(MDMMotionSolverChannel *channel, id target, double value) {
+  Class targetClass = object_getClass(target);
+  if (targetClass != channel->_setterClass) {
+    resolveSetter(channel, targetClass);
+  }
+  switch (channel->_setterType) {
+    case 'd':
+      ((void (*)(id, SEL, double))channel->_setterIMP)(target, channel->_setter, value);
+      break;
+    case 'f':
+      ((void (*)(id, SEL, float))channel->_setterIMP)(target, channel->_setter, (float)value);
+      break;
+    default:
+      [target setValue:@(value) forKeyPath:channel.keyPath];
+      break;
+  }
+}
+
+static void reallocateFields(double **fields, NSUInteger fieldCount, NSUInteger capacity) {
+  for (NSUInteger field = 0; field < fieldCount; field++) {
+    fields[field] = realloc(fields[field], capacity * sizeof(double));
+  }
+}
+
+static NSUInteger grownCapacity(NSUInteger capacity, NSUInteger requiredCapacity) {
+  return MAX(requiredCapacity, MAX((NSUInteger)16, capacity * 2));
+}
+
+// Moves the last element into the removed element's place.
+static void removeElement(double **fields, NSUInteger fieldCount,
+                          NSMutableArray<MDMMotionSolverChannel *> *channels, NSUInteger index) {
+  MDMMotionSolverChannel *channel = channels[index];
+  channel->_motion = MDMChannelMotionNone;
+  channel->_index = NSNotFound;
+
+  NSUInteger last = channels.count - 1;
+  if (index != last) {
+    for (NSUInteger field = 0; field < fieldCount; field++) {
+      fields[field][index] = fields[field][last];
+    }
+    MDMMotionSolverChannel *moved = channels[last];
+    moved->_index = index;
+    channels[index] = moved;
+  }
+  [channels removeLastObject];
+}
+
+@implementation MDMMotionSolver {
+  __weak MDMFrameScheduler *_frameScheduler;
+  BOOL _scheduled;
+
+  double *_springs[kSpringFieldCount];
+  NSMutableArray<MDMMotionSolverChannel *> *_springChannels;
+  NSUInteger _springCapacity;
+
+  double *_tweens[kTweenFieldCount];
+  NSMutableArray<MDMMotionSolverChannel *> *_tweenChannels;
+  NSUInteger _tweenCapacity;
+
+  // Scratch space for a single step, shared by both kinds of motion.
+  uint8_t *_atRest;
+  double *_values;
+  NSUInteger _scratchCapacity;
+}
+
+- (instancetype)initWithFrameScheduler:(MDMFrameScheduler *)frameScheduler {
+  self = [super init];
+  if (self) {
+    _frameScheduler = frameScheduler;
+    _springChannels = [NSMutableArray array];
+    _tweenChannels = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  for (NSUInteger field = 0; field < kSpringFieldCount; field++) {
+    free(_springs[field]);
+  }
+  for (NSUInteger field = 0; field < kTweenFieldCount; field++) {
+    free(_tweens[field]);
+  }
+  free(_atRest);
+  free(_values);
+}
+
+- (NSUInteger)activeSpringCount {
+  return _springChannels.count;
+}
+
+- (NSUInteger)activeTweenCount {
+  return _tweenChannels.count;
+}
+
+#pragma mark - Animating channels
+
+- (void)animateChannel:(MDMMotionSolverChannel *)channel
+            withSpring:(MDMSpring *)spring
+                 token:(id<MDMTokened>)token {
+  double position = 0;
+  switch (channel->_motion) {
+    case MDMChannelMotionSpring:
+      [self retargetChannel:channel withSpring:spring];
+      [self replaceTokenOfChannel:channel withToken:token];
+      return;
+    case MDMChannelMotionTween:
+      position = _tweens[kTweenPosition][channel->_index];
+      removeElement(_tweens, kTweenFieldCount, _tweenChannels, channel->_index);
+      break;
+    case MDMChannelMotionNone:
+      position = [[channel.target valueForKeyPath:channel.keyPath] doubleValue];
+      break;
+  }
+
+  NSUInteger index = _springChannels.count;
+  if (index == _springCapacity) {
+    _springCapacity = grownCapacity(_springCapacity, index + 1);
+    reallocateFields(_springs, kSpringFieldCount, _springCapacity);
+  }
+  _springs[kSpringPosition][index] = position;
+  _springs[kSpringVelocity][index] = 0;
+  _springs[kSpringDestination][index] = spring.destination;
+  _springs[kSpringStiffness][index] = spring.stiffness;
+  _springs[kSpringDamping][index] = spring.damping;
+  [_springChannels addObject:channel];
+  channel->_motion = MDMChannelMotionSpring;
+  channel->_index = index;
+
+  [self replaceTokenOfChannel:channel withToken:token];
+  [self scheduleIfNeeded];
+}
+
+- (BOOL)retargetChannel:(MDMMotionSolverChannel *)channel withSpring:(MDMSpring *)spring {
+  if (channel->_motion != MDMChannelMotionSpring) {
+    return NO;
+  }
+  NSUInteger index = channel->_index;
+  _springs[kSpringDestination][index] = spring.destination;
+  _springs[kSpringStiffness][index] = spring.stiffness;
+  _springs[kSpringDamping][index] = spring.damping;
+  return YES;
+}
+
+- (void)animateChannel:(MDMMotionSolverChannel *)channel
+             withTween:(MDMTween *)tween
+                 token:(id<MDMTokened>)token {
+  switch (channel->_motion) {
+    case MDMChannelMotionSpring:
+      removeElement(_springs, kSpringFieldCount, _springChannels, channel->_index);
+      break;
+    case MDMChannelMotionTween:
+      removeElement(_tweens, kTweenFieldCount, _tweenChannels, channel->_index);
+      break;
+    case MDMChannelMotionNone:
+      break;
+  }
+
+  NSUInteger index = _tweenChannels.count;
+  if (index == _tweenCapacity) {
+    _tweenCapacity = grownCapacity(_tweenCapacity, index + 1);
+    reallocateFields(_tweens, kTweenFieldCount, _tweenCapacity);
+  }
+  _tweens[kTweenPosition][index] = tween.from;
+  _tweens[kTweenElapsed][index] = 0;
+  _tweens[kTweenFrom][index] = tween.from;
+  _tweens[kTweenTo][index] = tween.to;
+  // The kernel divides by the duration.
+  _tweens[kTweenDuration][index] = MAX(tween.duration, DBL_MIN);
+  _tweens[kTweenEasing][index] =
+      tween.timingFunction == MDMTweenTimingFunctionEaseInOut ? 1 : 0;
+  [_tweenChannels addObject:channel];
+  channel->_motion = MDMChannelMotionTween;
+  channel->_index = index;
+
+  [self replaceTokenOfChannel:channel withToken:token];
+  [self scheduleIfNeeded];
+}
+
+- (void)stopChannel:(MDMMotionSolverChannel *)channel {
+  switch (channel->_motion) {
+    case MDMChannelMotionSpring:
+      removeElement(_springs, kSpringFieldCount, _springChannels, channel->_index);
+      break;
+    case MDMChannelMotionTween:
+      removeElement(_tweens, kTweenFieldCount, _tweenChannels, channel->_index);
+      break;
+    case MDMChannelMotionNone:
+      return;
+  }
+  id<MDMTokened> token = channel->_token;
+  channel->_token = nil;
+  token.active = NO;
+}
+
+#pragma mark - MDMFrameStepping
+
+- (BOOL)stepByTimeInterval:(NSTimeInterval)interval {
+  [self stepSpringsByTimeInterval:interval];
+  [self stepTweensByTimeInterval:interval];
+
+  // Applying values may have started new motions.
+  BOOL atRest = _springChannels.count == 0 && _tweenChannels.count == 0;
+  if (atRest) {
+    _scheduled = NO;
+  }
+  return atRest;
+}
+
+#pragma mark - Private
+
+- (void)scheduleIfNeeded {
+  if (_scheduled) {
+    return;
+  }
+  _scheduled = YES;
+  [_frameScheduler scheduleStepper:self token:nil];
+}
+
+- (void)replaceTokenOfChannel:(MDMMotionSolverChannel *)channel withToken:(id<MDMTokened>)token {
+  id<MDMTokened> previousToken = channel->_token;
+  channel->_token = token;
+
+  // The new token is activated first so that the runtime doesn't briefly become idle.
+  token.active = YES;
+  if (previousToken != token) {
+    previousToken.active = NO;
+  }
+}
+
+- (void)reserveScratchCapacity:(NSUInteger)count {
+  if (count <= _scratchCapacity) {
+    return;
+  }
+  _scratchCapacity = grownCapacity(_scratchCapacity, count);
+  _atRest = realloc(_atRest, _scratchCapacity * sizeof(uint8_t));
+  _values = realloc(_values, _scratchCapacity * sizeof(double));
+}
+
+- (void)stepSpringsByTimeInterval:(NSTimeInterval)interval {
+  NSUInteger count = _springChannels.count;
+  if (count == 0) {
+    return;
+  }
+  [self reserveScratchCapacity:count];
+
+  NSUInteger substeps = (NSUInteger)ceil(interval / kMaxSpringStep);
+  substeps = MIN(kMaxSpringSubsteps, MAX((NSUInteger)1, substeps));
+  NSTimeInterval substep = interval / (double)substeps;
+
+  MDMSpringState state = {
+      .position = _springs[kSpringPosition],
+      .velocity = _springs[kSpringVelocity],
+      .destination = _springs[kSpringDestination],
+      .stiffness = _springs[kSpringStiffness],
+      .damping = _springs[kSpringDamping],
+  };
+  size_t restCount = 0;
+  for (NSUInteger step = 0; step < substeps; step++) {
+    restCount = MDMSpringKernelStep(state, count, substep, kSpringRestThreshold, _atRest);
+  }
+  [self finishStepOfChannels:_springChannels
+                      fields:_springs
+                  fieldCount:kSpringFieldCount
+                       count:count
+                   restCount:restCount];
+}
+
+- (void)stepTweensByTimeInterval:(NSTimeInterval)interval {
+  NSUInteger count = _tweenChannels.count;
+  if (count == 0) {
+    return;
+  }
+  [self reserveScratchCapacity:count];
+
+  MDMTweenState state = {
+      .position = _tweens[kTweenPosition],
+      .elapsed = _tweens[kTweenElapsed],
+      .from = _tweens[kTweenFrom],
+      .to = _tweens[kTweenTo],
+      .duration = _tweens[kTweenDuration],
+      .easing = _tweens[kTweenEasing],
+  };
+  size_t restCount = MDMTweenKernelStep(state, count, interval, _atRest);
+  [self finishStepOfChannels:_tweenChannels
+                      fields:_tweens
+                  fieldCount:kTweenFieldCount
+                       count:count
+                   restCount:restCount];
+}
+
+// Removes the motions at rest, writes every stepped value to its target and then deactivates the
+// tokens of the motions at rest.
+- (void)finishStepOfChannels:(NSMutableArray<MDMMotionSolverChannel *> *)channels
+                      fields:(double **)fields
+                  fieldCount:(NSUInteger)fieldCount
+                       count:(NSUInteger)count
+                   restCount:(size_t)restCount {
+  // Writing a value can start or stop motions, so the values and channels are copied first.
+  memcpy(_values, fields[0], count * sizeof(double));
+  NSArray<MDMMotionSolverChannel *> *steppedChannels = [channels copy];
+
+  NSMutableArray<id<MDMTokened>> *restingTokens = nil;
+  if (restCount > 0) {
+    restingTokens = [NSMutableArray arrayWithCapacity:restCount];
+    // In reverse so that every element moved by a removal has already been visited.
+    for (NSUInteger index = count; index-- > 0;) {
+      if (!_atRest[index]) {
+        continue;
+      }
+      MDMMotionSolverChannel *channel = channels[index];
+      removeElement(fields, fieldCount, channels, index);
+      if (channel->_token) {
+        [restingTokens addObject:channel->_token];
+        channel->_token = nil;
+      }
+    }
+  }
+
+  for (NSUInteger index = 0; index < count; index++) {
+    MDMMotionSolverChannel *channel = steppedChannels[index];
+    id target = channel.target;
+    if (target) {
+      setChannelValue(channel, target, _values[index]);
+    } else {
+      // Nothing is left to animate.
+      [self stopChannel:channel];
+    }
+  }
+
+  for (id<MDMTokened> token in restingTokens) {
+    token.active = NO;
+  }
+}
+
+@end
@@ -0,0 +1,240 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "MDMMotionSolverKernels.h"
+
+#include <math.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MDM_SOLVER_LANES 4
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MDM_SOLVER_LANES 2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MDM_SOLVER_LANES 2
+#else
+#define MDM_SOLVER_LANES 1
+#endif
+
+// Scalar
+
+static inline uint8_t springStep(MDMSpringState state, size_t i, double interval,
+                                 double restThreshold) {
+  double position = state.position[i];
+  double velocity = state.velocity[i];
+  double destination = state.destination[i];
+  double acceleration =
+      -state.stiffness[i] * (position - destination) - state.damping[i] * velocity;
+  velocity += acceleration * interval;
+  position += velocity * interval;
+  uint8_t rest = fabs(position - destination) < restThreshold && fabs(velocity) < restThreshold;
+  if (rest) {
+    position = destination;
+    velocity = 0;
+  }
+  state.position[i] = position;
+  state.velocity[i] = velocity;
+  return rest;
+}
+
+static inline uint8_t tweenStep(MDMTweenState state, size_t i, double interval) {
+  double elapsed = state.elapsed[i] + interval;
+  double progress = fmin(elapsed / state.duration[i], 1);
+  double smoothed = progress * progress * (3 - 2 * progress);
+  double eased = progress + state.easing[i] * (smoothed - progress);
+  uint8_t rest = elapsed >= state.duration[i];
+  state.elapsed[i] = elapsed;
+  state.position[i] = rest ? state.to[i] : state.from[i] + (state.to[i] - state.from[i]) * eased;
+  return rest;
+}
+
+#if MDM_SOLVER_LANES > 1
+
+// Expands the low bits of a lane mask into one byte per lane and returns the number of set lanes.
+static inline size_t storeLaneMask(uint8_t *atRest, unsigned int mask) {
+  size_t count = 0;
+  for (unsigned int lane = 0; lane < MDM_SOLVER_LANES; lane++) {
+    uint8_t rest = (uint8_t)((mask >> lane) & 1u);
+    atRest[lane] = rest;
+    count += rest;
+  }
+  return count;
+}
+
+#endif
+
+// Springs
+
+size_t MDMSpringKernelStep(MDMSpringState state, size_t count, double interval,
+                           double restThreshold, uint8_t *atRest) {
+  size_t restCount = 0;
+  size_t i = 0;
+
+#if defined(__AVX__)
+  const __m256d dt = _mm256_set1_pd(interval);
+  const __m256d threshold = _mm256_set1_pd(restThreshold);
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d zero = _mm256_setzero_pd();
+  for (; i + 4 <= count; i += 4) {
+    __m256d position = _mm256_loadu_pd(state.position + i);
+    __m256d velocity = _mm256_loadu_pd(state.velocity + i);
+    __m256d destination = _mm256_loadu_pd(state.destination + i);
+    __m256d force = _mm256_add_pd(
+        _mm256_mul_pd(_mm256_loadu_pd(state.stiffness + i), _mm256_sub_pd(position, destination)),
+        _mm256_mul_pd(_mm256_loadu_pd(state.damping + i), velocity));
+    velocity = _mm256_sub_pd(velocity, _mm256_mul_pd(force, dt));
+    position = _mm256_add_pd(position, _mm256_mul_pd(velocity, dt));
+    __m256d distance = _mm256_andnot_pd(sign, _mm256_sub_pd(position, destination));
+    __m256d speed = _mm256_andnot_pd(sign, velocity);
+    __m256d rest = _mm256_and_pd(_mm256_cmp_pd(distance, threshold, _CMP_LT_OQ),
+                                 _mm256_cmp_pd(speed, threshold, _CMP_LT_OQ));
+    _mm256_storeu_pd(state.position + i, _mm256_blendv_pd(position, destination, rest));
+    _mm256_storeu_pd(state.velocity + i, _mm256_blendv_pd(velocity, zero, rest));
+    restCount += storeLaneMask(atRest + i, (unsigned int)_mm256_movemask_pd(rest));
+  }
+#elif defined(__SSE2__)
+  const __m128d dt = _mm_set1_pd(interval);
+  const __m128d threshold = _mm_set1_pd(restThreshold);
+  const __m128d sign = _mm_set1_pd(-0.0);
+  for (; i + 2 <= count; i += 2) {
+    __m128d position = _mm_loadu_pd(state.position + i);
+    __m128d velocity = _mm_loadu_pd(state.velocity + i);
+    __m128d destination = _mm_loadu_pd(state.destination + i);
+    __m128d force = _mm_add_pd(
+        _mm_mul_pd(_mm_loadu_pd(state.stiffness + i), _mm_sub_pd(position, destination)),
+        _mm_mul_pd(_mm_loadu_pd(state.damping + i), velocity));
+    velocity = _mm_sub_pd(velocity, _mm_mul_pd(force, dt));
+    position = _mm_add_pd(position, _mm_mul_pd(velocity, dt));
+    __m128d distance = _mm_andnot_pd(sign, _mm_sub_pd(position, destination));
+    __m128d speed = _mm_andnot_pd(sign, velocity);
+    __m128d rest = _mm_and_pd(_mm_cmplt_pd(distance, threshold), _mm_cmplt_pd(speed, threshold));
+    // SSE2 has no blend instruction.
+    position = _mm_or_pd(_mm_and_pd(rest, destination), _mm_andnot_pd(rest, position));
+    velocity = _mm_andnot_pd(rest, velocity);
+    _mm_storeu_pd(state.position + i, position);
+    _mm_storeu_pd(state.velocity + i, velocity);
+    restCount += storeLaneMask(atRest + i, (unsigned int)_mm_movemask_pd(rest));
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const float64x2_t threshold = vdupq_n_f64(restThreshold);
+  const float64x2_t zero = vdupq_n_f64(0);
+  for (; i + 2 <= count; i += 2) {
+    float64x2_t position = vld1q_f64(state.position + i);
+    float64x2_t velocity = vld1q_f64(state.velocity + i);
+    float64x2_t destination = vld1q_f64(state.destination + i);
+    float64x2_t force = vaddq_f64(
+        vmulq_f64(vld1q_f64(state.stiffness + i), vsubq_f64(position, destination)),
+        vmulq_f64(vld1q_f64(state.damping + i), velocity));
+    velocity = vsubq_f64(velocity, vmulq_n_f64(force, interval));
+    position = vaddq_f64(position, vmulq_n_f64(velocity, interval));
+    uint64x2_t rest = vandq_u64(vcltq_f64(vabsq_f64(vsubq_f64(position, destination)), threshold),
+                                vcltq_f64(vabsq_f64(velocity), threshold));
+    vst1q_f64(state.position + i, vbslq_f64(rest, destination, position));
+    vst1q_f64(state.velocity + i, vbslq_f64(rest, zero, velocity));
+    unsigned int mask = (unsigned int)(vgetq_lane_u64(rest, 0) & 1u)
+                        | (unsigned int)((vgetq_lane_u64(rest, 1) & 1u) << 1);
+    restCount += storeLaneMask(atRest + i, mask);
+  }
+#endif
+
+  for (; i < count; i++) {
+    atRest[i] = springStep(state, i, interval, restThreshold);
+    restCount += atRest[i];
+  }
+  return restCount;
+}
+
+// Tweens
+
+size_t MDMTweenKernelStep(MDMTweenState state, size_t count, double interval, uint8_t *atRest) {
+  size_t restCount = 0;
+  size_t i = 0;
+
+#if defined(__AVX__)
+  const __m256d dt = _mm256_set1_pd(interval);
+  const __m256d one = _mm256_set1_pd(1);
+  const __m256d two = _mm256_set1_pd(2);
+  const __m256d three = _mm256_set1_pd(3);
+  for (; i + 4 <= count; i += 4) {
+    __m256d elapsed = _mm256_add_pd(_mm256_loadu_pd(state.elapsed + i), dt);
+    __m256d duration = _mm256_loadu_pd(state.duration + i);
+    __m256d progress = _mm256_min_pd(_mm256_div_pd(elapsed, duration), one);
+    __m256d smoothed = _mm256_mul_pd(_mm256_mul_pd(progress, progress),
+                                     _mm256_sub_pd(three, _mm256_mul_pd(two, progress)));
+    __m256d eased = _mm256_add_pd(
+        progress, _mm256_mul_pd(_mm256_loadu_pd(state.easing + i),
+                                _mm256_sub_pd(smoothed, progress)));
+    __m256d from = _mm256_loadu_pd(state.from + i);
+    __m256d to = _mm256_loadu_pd(state.to + i);
+    __m256d position = _mm256_add_pd(from, _mm256_mul_pd(_mm256_sub_pd(to, from), eased));
+    __m256d rest = _mm256_cmp_pd(elapsed, duration, _CMP_GE_OQ);
+    _mm256_storeu_pd(state.elapsed + i, elapsed);
+    _mm256_storeu_pd(state.position + i, _mm256_blendv_pd(position, to, rest));
+    restCount += storeLaneMask(atRest + i, (unsigned int)_mm256_movemask_pd(rest));
+  }
+#elif defined(__SSE2__)
+  const __m128d dt = _mm_set1_pd(interval);
+  const __m128d one = _mm_set1_pd(1);
+  const __m128d two = _mm_set1_pd(2);
+  const __m128d three = _mm_set1_pd(3);
+  for (; i + 2 <= count; i += 2) {
+    __m128d elapsed = _mm_add_pd(_mm_loadu_pd(state.elapsed + i), dt);
+    __m128d duration = _mm_loadu_pd(state.duration + i);
+    __m128d progress = _mm_min_pd(_mm_div_pd(elapsed, duration), one);
+    __m128d smoothed = _mm_mul_pd(_mm_mul_pd(progress, progress),
+                                  _mm_sub_pd(three, _mm_mul_pd(two, progress)));
+    __m128d eased = _mm_add_pd(
+        progress, _mm_mul_pd(_mm_loadu_pd(state.easing + i), _mm_sub_pd(smoothed, progress)));
+    __m128d from = _mm_loadu_pd(state.from + i);
+    __m128d to = _mm_loadu_pd(state.to + i);
+    __m128d position = _mm_add_pd(from, _mm_mul_pd(_mm_sub_pd(to, from), eased));
+    __m128d rest = _mm_cmpge_pd(elapsed, duration);
+    position = _mm_or_pd(_mm_and_pd(rest, to), _mm_andnot_pd(rest, position));
+    _mm_storeu_pd(state.elapsed + i, elapsed);
+    _mm_storeu_pd(state.position + i, position);
+    restCount += storeLaneMask(atRest + i, (unsigned int)_mm_movemask_pd(rest));
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const float64x2_t one = vdupq_n_f64(1);
+  const float64x2_t three = vdupq_n_f64(3);
+  for (; i + 2 <= count; i += 2) {
+    float64x2_t elapsed = vaddq_f64(vld1q_f64(state.elapsed + i), vdupq_n_f64(interval));
+    float64x2_t duration = vld1q_f64(state.duration + i);
+    float64x2_t progress = vminq_f64(vdivq_f64(elapsed, duration), one);
+    float64x2_t smoothed = vmulq_f64(vmulq_f64(progress, progress),
+                                     vsubq_f64(three, vmulq_n_f64(progress, 2)));
+    float64x2_t eased =
+        vaddq_f64(progress, vmulq_f64(vld1q_f64(state.easing + i), vsubq_f64(smoothed, progress)));
+    float64x2_t from = vld1q_f64(state.from + i);
+    float64x2_t to = vld1q_f64(state.to + i);
+    float64x2_t position = vaddq_f64(from, vmulq_f64(vsubq_f64(to, from), eased));
+    uint64x2_t rest = vcgeq_f64(elapsed, duration);
+    vst1q_f64(state.elapsed + i, elapsed);
+    vst1q_f64(state.position + i, vbslq_f64(rest, to, position));
+    unsigned int mask = (unsigned int)(vgetq_lane_u64(rest, 0) & 1u)
+                        | (unsigned int)((vgetq_lane_u64(rest, 1) & 1u) << 1);
+    restCount += storeLaneMask(atRest + i, mask);
+  }
+#endif
+
+  for (; i < count; i++) {
+    atRest[i] = tweenStep(state, i, interval);
+    restCount += atRest[i];
+  }
+  return restCount;
+}
@@ -0,0 +1,77 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ Integration kernels for MDMMotionSolver.
+
+ State is stored as one contiguous array per field so that the kernels can step several elements at
+ once with AVX, SSE2 or NEON instructions. A scalar loop handles the remaining elements and
+ platforms without a supported instruction set.
+ */
+
+/** The fields of a set of springs, one array element per spring. */
+typedef struct {
+  double *position;
+  double *velocity;
+  const double *destination;
+  const double *stiffness;
+  const double *damping;
+} MDMSpringState;
+
+/**
+ Advances count springs of unit mass by interval using semi-implicit Euler integration.
+
+ A spring whose distance to its destination and whose speed are both below restThreshold is snapped
+ to its destination and its velocity is zeroed. atRest[i] is set to 1 for springs at rest and to 0
+ otherwise.
+
+ @return The number of springs at rest.
+ */
+size_t MDMSpringKernelStep(MDMSpringState state, size_t count, double interval,
+                           double restThreshold, uint8_t *atRest);
+
+/** The fields of a set of tweens, one array element per tween. */
+typedef struct {
+  double *position;
+  double *elapsed;
+  const double *from;
+  const double *to;
+  // Must be positive.
+  const double *duration;
+  // 0 for linear progress, 1 for smoothstep ease-in-out progress. Values between mix the two.
+  const double *easing;
+} MDMTweenState;
+
+/**
+ Advances count tweens by interval.
+
+ atRest[i] is set to 1 for tweens whose elapsed time has reached their duration, and to 0 otherwise.
+ A tween at rest is positioned at its to value.
+
+ @return The number of tweens at rest.
+ */
+size_t MDMTweenKernelStep(MDMTweenState state, size_t count, double interval, uint8_t *atRest);
+
+#if defined(__cplusplus)
+}
+#endif
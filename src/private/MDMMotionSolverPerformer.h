@@ -0,0 +1,30 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMMotionSolver.h"
+#import "MDMPerforming.h"
+
+/**
+ Performs MDMSpring and MDMTween plans by driving one motion solver channel per key path of its
+ target.
+
+ Removing a named spring or tween stops the motion of its key path. Replacing a named spring with a
+ spring for the same key path retargets the running motion, keeping its velocity and token.
+ */
+@interface MDMMotionSolverPerformer : NSObject <MDMMotionSolverPerforming, MDMNamedPlanPerforming>
+@end
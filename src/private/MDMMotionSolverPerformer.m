@@ -0,0 +1,137 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMMotionSolverPerformer.h"
+
+#import "MDMSpring.h"
+#import "MDMTween.h"
+
+@implementation MDMMotionSolverPerformer {
+  __weak id _target;
+  MDMMotionSolver *_motionSolver;
+  id<MDMPlanTokenizing> _planTokenizer;
+  NSMutableDictionary<NSString *, MDMMotionSolverChannel *> *_keyPathToChannel;
+  NSMutableDictionary<NSString *, NSString *> *_nameToKeyPath;
+  // The name of the plan currently driving each key path. Absent if an unnamed plan drives it.
+  NSMutableDictionary<NSString *, NSString *> *_keyPathToName;
+}
+
+- (instancetype)initWithTarget:(id)target {
+  self = [super init];
+  if (self) {
+    _target = target;
+    _keyPathToChannel = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  for (MDMMotionSolverChannel *channel in _keyPathToChannel.objectEnumerator) {
+    [_motionSolver stopChannel:channel];
+  }
+}
+
+- (void)setMotionSolver:(MDMMotionSolver *)motionSolver {
+  _motionSolver = motionSolver;
+}
+
+- (void)givePlanTokenizer:(id<MDMPlanTokenizing>)planTokenizer {
+  _planTokenizer = planTokenizer;
+}
+
+#pragma mark - MDMPerforming
+
+- (void)addPlan:(id<MDMPlan>)plan {
+  NSString *keyPath = [self animateWithPlan:plan];
+  [_keyPathToName removeObjectForKey:keyPath];
+}
+
+#pragma mark - MDMNamedPlanPerforming
+
+- (void)addPlan:(id<MDMNamedPlan>)plan named:(NSString *)name {
+  NSString *keyPath = [self animateWithPlan:plan];
+  if (!_nameToKeyPath) {
+    _nameToKeyPath = [NSMutableDictionary dictionary];
+    _keyPathToName = [NSMutableDictionary dictionary];
+  }
+  _nameToKeyPath[name] = keyPath;
+  _keyPathToName[keyPath] = name;
+}
+
+- (void)replacePlanNamed:(NSString *)name withPlan:(id<MDMNamedPlan>)plan {
+  NSString *keyPath = _nameToKeyPath[name];
+  // A spring replacing the running spring of its key path keeps the motion's velocity and token,
+  // so that a spring re-added on every frame of a gesture never comes to rest in between.
+  if (keyPath && [plan isKindOfClass:[MDMSpring class]]
+      && [((MDMSpring *)plan).keyPath isEqualToString:keyPath]
+      && [_keyPathToName[keyPath] isEqualToString:name]
+      && [_motionSolver retargetChannel:_keyPathToChannel[keyPath] withSpring:(MDMSpring *)plan]) {
+    return;
+  }
+  // Animating the same key path replaces its motion, so the channel is only stopped if the new
+  // plan animates a different key path.
+  if (keyPath && ![keyPath isEqualToString:[(id)plan keyPath]]) {
+    [self removePlanNamed:name];
+  }
+  [self addPlan:plan named:name];
+}
+
+- (void)removePlanNamed:(NSString *)name {
+  NSString *keyPath = _nameToKeyPath[name];
+  if (!keyPath) {
+    return;
+  }
+  [_nameToKeyPath removeObjectForKey:name];
+  // A later plan on the same key path has replaced this one and is left running.
+  if (![_keyPathToName[keyPath] isEqualToString:name]) {
+    return;
+  }
+  [_keyPathToName removeObjectForKey:keyPath];
+  MDMMotionSolverChannel *channel = _keyPathToChannel[keyPath];
+  if (channel) {
+    [_motionSolver stopChannel:channel];
+  }
+}
+
+#pragma mark - Private
+
+// Returns the animated key path.
+- (NSString *)animateWithPlan:(id<MDMPlan>)plan {
+  id<MDMTokened> token = [_planTokenizer tokenForPlan:plan];
+  if ([plan isKindOfClass:[MDMSpring class]]) {
+    MDMSpring *spring = (MDMSpring *)plan;
+    [_motionSolver animateChannel:[self channelForKeyPath:spring.keyPath]
+                       withSpring:spring
+                            token:token];
+    return spring.keyPath;
+  }
+  MDMTween *tween = (MDMTween *)plan;
+  [_motionSolver animateChannel:[self channelForKeyPath:tween.keyPath]
+                      withTween:tween
+                          token:token];
+  return tween.keyPath;
+}
+
+- (MDMMotionSolverChannel *)channelForKeyPath:(NSString *)keyPath {
+  MDMMotionSolverChannel *channel = _keyPathToChannel[keyPath];
+  if (!channel) {
+    channel = [[MDMMotionSolverChannel alloc] initWithTarget:_target keyPath:keyPath];
+    _keyPathToChannel[keyPath] = channel;
+  }
+  return channel;
+}
+
+@end
@@ -0,0 +1,42 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class MDMPlanName;
+@protocol MDMNamedPlan;
+
+/**
+ Buffers named plan mutations and keeps only the final state for each (target, name) pair.
+
+ A nil plan represents a removal.
+ */
+@interface MDMNamedPlanTransaction : NSObject
+
+/** Records the final state of the given name on the given target. */
+- (void)setPlan:(nullable id<MDMNamedPlan>)plan
+          named:(nonnull MDMPlanName *)name
+      forTarget:(nonnull id)target;
+
+/**
+ Invokes the block once per touched (target, name) pair in order of first touch and then empties
+ the receiver.
+ */
+- (void)drainUsingBlock:(void (^_Nonnull)(id _Nonnull target,
+                                          MDMPlanName *_Nonnull name,
+                                          id<MDMNamedPlan> _Nullable plan))block;
+
+@end
@@ -0,0 +1,83 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMNamedPlanTransaction.h"
+
+#import "MDMPlan.h"
+#import "MDMPlanName.h"
+
+@interface MDMNamedPlanChange : NSObject {
+ @package
+  id _target;
+  MDMPlanName *_name;
+  id<MDMNamedPlan> _plan;
+}
+@end
+
+@implementation MDMNamedPlanChange
+@end
+
+@implementation MDMNamedPlanTransaction {
+  // Target -> MDMPlanName identifier -> change.
+  NSMapTable<id, NSMapTable *> *_targetToChanges;
+  NSMutableArray<MDMNamedPlanChange *> *_orderedChanges;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _targetToChanges = [NSMapTable
+        mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory
+                                | NSPointerFunctionsObjectPointerPersonality)
+                  valueOptions:NSPointerFunctionsStrongMemory];
+    _orderedChanges = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)setPlan:(id<MDMNamedPlan>)plan named:(MDMPlanName *)name forTarget:(id)target {
+  NSMapTable *changes = [_targetToChanges objectForKey:target];
+  if (!changes) {
+    changes = [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsOpaqueMemory
+                                                      | NSPointerFunctionsIntegerPersonality)
+                                        valueOptions:NSPointerFunctionsStrongMemory
+                                            capacity:0];
+    [_targetToChanges setObject:changes forKey:target];
+  }
+
+  void *key = (void *)(uintptr_t)name.identifier;
+  MDMNamedPlanChange *change = (__bridge MDMNamedPlanChange *)NSMapGet(changes, key);
+  if (!change) {
+    change = [MDMNamedPlanChange new];
+    change->_target = target;
+    change->_name = name;
+    NSMapInsert(changes, key, (__bridge void *)change);
+    [_orderedChanges addObject:change];
+  }
+  change->_plan = plan;
+}
+
+- (void)drainUsingBlock:(void (^)(id, MDMPlanName *, id<MDMNamedPlan>))block {
+  NSArray<MDMNamedPlanChange *> *changes = _orderedChanges;
+  _orderedChanges = [NSMutableArray array];
+  [_targetToChanges removeAllObjects];
+
+  for (MDMNamedPlanChange *change in changes) {
+    block(change->_target, change->_name, change->_plan);
+  }
+}
+
+@end
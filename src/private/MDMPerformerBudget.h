@@ -0,0 +1,99 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class MDMPerformerDescriptor;
+@class MDMTargetScope;
+@protocol MDMPerforming;
+
+/**
+ The bookkeeping for one performer slot of a target scope.
+
+ The entry outlives its performer when the performer is evicted, so that a rehydratable performer
+ can be recreated from the plans the entry retained.
+ */
+@interface MDMPerformerEntry : NSObject {
+ @package
+  // nil while the performer is evicted.
+  id<MDMPerforming> _performer;
+  MDMPerformerDescriptor *_descriptor;
+  __weak MDMTargetScope *_scope;
+
+  NSUInteger _activeTokenCount;
+  NSUInteger _namedPlanCount;
+  NSUInteger _unnamedPlanCount;
+  // The unnamed plans received by a rehydratable performer while the budget was enabled, in order.
+  NSMutableArray *_retainedPlans;
+
+  // Links of the budget's idle list, ordered from least to most recently idle.
+  MDMPerformerEntry *_nextIdle;
+  __unsafe_unretained MDMPerformerEntry *_previousIdle;
+  BOOL _isInIdleList;
+}
+
+/** Whether the performer exists and could be evicted without losing state. */
+@property(nonatomic, assign, readonly, getter=isEvictable) BOOL evictable;
+
+@end
+
+/**
+ Enforces a runtime-wide limit on the number of live performers.
+
+ Evictable performers are kept in least-recently-idle order. When the number of live performers
+ exceeds the limit, the least recently idle performers are evicted first.
+ */
+@interface MDMPerformerBudget : NSObject
+
+/**
+ The maximum number of live performers. 0 means unlimited.
+
+ Setting the maximum to 0 empties the idle list.
+ */
+@property(nonatomic, assign) NSUInteger maximumPerformerCount;
+
+/**
+ Whether maximumPerformerCount is non-zero.
+
+ Scopes only retain plans for rehydration and report entry use while the budget is enabled.
+ */
+@property(nonatomic, assign, readonly, getter=isEnabled) BOOL enabled;
+
+@property(nonatomic, assign, readonly) NSUInteger livePerformerCount;
+
+/** The largest livePerformerCount observed. */
+@property(nonatomic, assign, readonly) NSUInteger peakLivePerformerCount;
+@property(nonatomic, assign, readonly) NSUInteger evictionCount;
+@property(nonatomic, assign, readonly) NSUInteger rehydrationCount;
+
+/** Informs the budget that the entry's performer was created. */
+- (void)entryDidCreatePerformer:(nonnull MDMPerformerEntry *)entry rehydrated:(BOOL)rehydrated;
+
+/** Informs the budget that the entry's performer was released by its scope. */
+- (void)entryDidReleasePerformer:(nonnull MDMPerformerEntry *)entry;
+
+/**
+ Moves the entry to the most recently idle end of the idle list if it is evictable, or removes it
+ from the idle list otherwise.
+
+ Does nothing while the budget is disabled.
+ */
+- (void)touchEntry:(nonnull MDMPerformerEntry *)entry;
+
+/** Evicts least recently idle performers until the live performer count fits the budget. */
+- (void)evictIfNeeded;
+
+@end
@@ -0,0 +1,136 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMPerformerBudget.h"
+
+#import "MDMPerformerDescriptor.h"
+#import "MDMTargetScope.h"
+
+@implementation MDMPerformerEntry
+
+- (BOOL)isEvictable {
+  if (!_performer || _activeTokenCount > 0 || _namedPlanCount > 0) {
+    return NO;
+  }
+  // A rehydratable performer can only be rebuilt if every one of its unnamed plans was retained.
+  return _unnamedPlanCount == 0
+      || ((_descriptor.capabilities & MDMPerformerCapabilityRehydratable)
+          && _retainedPlans.count == _unnamedPlanCount);
+}
+
+@end
+
+@implementation MDMPerformerBudget {
+  MDMPerformerEntry *_oldestIdle;
+  __unsafe_unretained MDMPerformerEntry *_newestIdle;
+}
+
+- (void)entryDidCreatePerformer:(MDMPerformerEntry *)entry rehydrated:(BOOL)rehydrated {
+  _livePerformerCount++;
+  _peakLivePerformerCount = MAX(_peakLivePerformerCount, _livePerformerCount);
+  if (rehydrated) {
+    _rehydrationCount++;
+  }
+}
+
+- (void)entryDidReleasePerformer:(MDMPerformerEntry *)entry {
+  [self unlinkEntry:entry];
+  _livePerformerCount--;
+}
+
+- (BOOL)isEnabled {
+  return _maximumPerformerCount > 0;
+}
+
+- (void)setMaximumPerformerCount:(NSUInteger)maximumPerformerCount {
+  _maximumPerformerCount = maximumPerformerCount;
+  if (maximumPerformerCount == 0) {
+    while (_oldestIdle) {
+      [self unlinkEntry:_oldestIdle];
+    }
+  }
+}
+
+- (void)touchEntry:(MDMPerformerEntry *)entry {
+  if (_maximumPerformerCount == 0) {
+    return;
+  }
+  [self unlinkEntry:entry];
+  if (entry.isEvictable) {
+    [self appendEntry:entry];
+  }
+}
+
+- (void)evictIfNeeded {
+  if (_maximumPerformerCount == 0) {
+    return;
+  }
+  while (_livePerformerCount > _maximumPerformerCount && _oldestIdle) {
+    MDMPerformerEntry *entry = _oldestIdle;
+    [self unlinkEntry:entry];
+
+    MDMTargetScope *scope = entry->_scope;
+    if (scope) {
+      [scope evictPerformerOfEntry:entry];
+    } else {
+      // The scope's target has been deallocated. Release the performer with the current pool.
+      __autoreleasing id retiredPerformer = entry->_performer;
+      (void)retiredPerformer;
+      entry->_performer = nil;
+      _livePerformerCount--;
+    }
+    _evictionCount++;
+  }
+}
+
+#pragma mark - Private
+
+- (void)appendEntry:(MDMPerformerEntry *)entry {
+  entry->_isInIdleList = YES;
+  entry->_previousIdle = _newestIdle;
+  entry->_nextIdle = nil;
+  if (_newestIdle) {
+    _newestIdle->_nextIdle = entry;
+  } else {
+    _oldestIdle = entry;
+  }
+  _newestIdle = entry;
+}
+
+- (void)unlinkEntry:(MDMPerformerEntry *)entry {
+  if (!entry->_isInIdleList) {
+    return;
+  }
+  // Keep the entry alive while its neighbors' strong links are rewired.
+  MDMPerformerEntry *strongEntry = entry;
+  MDMPerformerEntry *next = strongEntry->_nextIdle;
+  MDMPerformerEntry *previous = strongEntry->_previousIdle;
+  if (previous) {
+    previous->_nextIdle = next;
+  } else {
+    _oldestIdle = next;
+  }
+  if (next) {
+    next->_previousIdle = previous;
+  } else {
+    _newestIdle = previous;
+  }
+  strongEntry->_nextIdle = nil;
+  strongEntry->_previousIdle = nil;
+  strongEntry->_isInIdleList = NO;
+}
+
+@end
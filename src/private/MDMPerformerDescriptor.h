@@ -0,0 +1,82 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/** The optional performer features that a runtime needs to know about. */
+typedef NS_OPTIONS(NSUInteger, MDMPerformerCapabilities) {
+  MDMPerformerCapabilityNone = 0,
+
+  /** Instances conform to MDMContinuousPerforming. */
+  MDMPerformerCapabilityContinuous = 1 << 0,
+
+  /** Instances conform to MDMComposablePerforming. */
+  MDMPerformerCapabilityComposable = 1 << 1,
+
+  /** Instances conform to MDMNamedPlanPerforming. */
+  MDMPerformerCapabilityNamed = 1 << 2,
+
+  /** Instances implement MDMPerforming's addPlans:. */
+  MDMPerformerCapabilityBatch = 1 << 3,
+
+  /** Instances implement MDMNamedPlanPerforming's replacePlanNamed:withPlan:. */
+  MDMPerformerCapabilityReplace = 1 << 4,
+
+  /** Instances conform to MDMRehydratablePerforming. */
+  MDMPerformerCapabilityRehydratable = 1 << 5,
+
+  /** Instances conform to MDMFrameScheduledPerforming. */
+  MDMPerformerCapabilityFrameScheduled = 1 << 6,
+
+  /** Instances conform to MDMMotionSolverPerforming. */
+  MDMPerformerCapabilityMotionSolver = 1 << 7,
+};
+
+/** Describes a performer class as seen by a single runtime. */
+@interface MDMPerformerDescriptor : NSObject
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/** The described performer class. */
+@property(nonatomic, strong, nonnull, readonly) Class performerClass;
+
+/**
+ The index at which target scopes store instances of this performer class.
+
+ Slots are dense and assigned in the order in which performer classes are first seen.
+ */
+@property(nonatomic, assign, readonly) NSUInteger slot;
+
+/** The capabilities of the performer class, computed once when the descriptor is created. */
+@property(nonatomic, assign, readonly) MDMPerformerCapabilities capabilities;
+
+@end
+
+/**
+ A table of performer descriptors keyed by Class pointer identity.
+
+ One table is shared by all of the target scopes and the token pool of a runtime.
+ */
+@interface MDMPerformerDescriptorTable : NSObject
+
+/** Returns the descriptor for the given performer class, creating it on first use. */
+- (nonnull MDMPerformerDescriptor *)descriptorForPerformerClass:(nonnull Class)performerClass;
+
+/** The number of performer classes seen so far. Also the next slot to be assigned. */
+@property(nonatomic, assign, readonly) NSUInteger count;
+
+@end
@@ -0,0 +1,105 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMPerformerDescriptor.h"
+
+#import "MDMMotionSolver.h"
+#import "MDMPerforming.h"
+
+static MDMPerformerCapabilities capabilitiesOfPerformerClass(Class performerClass) {
+  MDMPerformerCapabilities capabilities = MDMPerformerCapabilityNone;
+  if ([performerClass instancesRespondToSelector:@selector(givePlanTokenizer:)]) {
+    capabilities |= MDMPerformerCapabilityContinuous;
+  }
+  if ([performerClass instancesRespondToSelector:@selector(setPlanEmitter:)]) {
+    capabilities |= MDMPerformerCapabilityComposable;
+  }
+  if ([performerClass instancesRespondToSelector:@selector(addPlan:named:)]
+      && [performerClass instancesRespondToSelector:@selector(removePlanNamed:)]) {
+    capabilities |= MDMPerformerCapabilityNamed;
+    if ([performerClass instancesRespondToSelector:@selector(replacePlanNamed:withPlan:)]) {
+      capabilities |= MDMPerformerCapabilityReplace;
+    }
+  }
+  if ([performerClass instancesRespondToSelector:@selector(addPlans:)]) {
+    capabilities |= MDMPerformerCapabilityBatch;
+  }
+  if ([performerClass conformsToProtocol:@protocol(MDMRehydratablePerforming)]) {
+    capabilities |= MDMPerformerCapabilityRehydratable;
+  }
+  if ([performerClass instancesRespondToSelector:@selector(setFrameScheduler:)]) {
+    capabilities |= MDMPerformerCapabilityFrameScheduled;
+  }
+  if ([performerClass instancesRespondToSelector:@selector(setMotionSolver:)]) {
+    capabilities |= MDMPerformerCapabilityMotionSolver;
+  }
+  return capabilities;
+}
+
+@implementation MDMPerformerDescriptor
+
+- (instancetype)initWithPerformerClass:(Class)performerClass slot:(NSUInteger)slot {
+  self = [super init];
+  if (self) {
+    _performerClass = performerClass;
+    _slot = slot;
+    _capabilities = capabilitiesOfPerformerClass(performerClass);
+  }
+  return self;
+}
+
+@end
+
+@implementation MDMPerformerDescriptorTable {
+  NSMapTable<Class, MDMPerformerDescriptor *> *_classToDescriptor;
+
+  // Plans of the same type tend to be added in runs, so the most recent lookup is cached.
+  __unsafe_unretained Class _lastPerformerClass;
+  MDMPerformerDescriptor *_lastDescriptor;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _classToDescriptor =
+        [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsOpaqueMemory
+                                                | NSPointerFunctionsOpaquePersonality)
+                                  valueOptions:NSPointerFunctionsStrongMemory
+                                      capacity:0];
+  }
+  return self;
+}
+
+- (MDMPerformerDescriptor *)descriptorForPerformerClass:(Class)performerClass {
+  if (performerClass == _lastPerformerClass) {
+    return _lastDescriptor;
+  }
+  MDMPerformerDescriptor *descriptor = [_classToDescriptor objectForKey:performerClass];
+  if (!descriptor) {
+    descriptor = [[MDMPerformerDescriptor alloc] initWithPerformerClass:performerClass
+                                                                   slot:_classToDescriptor.count];
+    [_classToDescriptor setObject:descriptor forKey:performerClass];
+  }
+  _lastPerformerClass = performerClass;
+  _lastDescriptor = descriptor;
+  return descriptor;
+}
+
+- (NSUInteger)count {
+  return _classToDescriptor.count;
+}
+
+@end
@@ -0,0 +1,32 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMPerformerLatencyRecorder.h"
+
+@interface MDMPerformerLatencyRecorder ()
+
+/**
+ Records one callback invocation.
+
+ The performer slot identifies the performer class within the runtime's performer descriptor
+ table.
+ */
+- (void)recordNanoseconds:(uint64_t)nanoseconds
+               ofCallback:(MDMPerformerCallback)callback
+            performerSlot:(NSUInteger)performerSlot
+           performerClass:(nonnull Class)performerClass;
+
+@end
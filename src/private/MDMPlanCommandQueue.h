@@ -0,0 +1,77 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class MDMPlanName;
+
+/** The runtime mutations that can be carried by an MDMPlanCommand. */
+typedef NS_ENUM(uint8_t, MDMPlanCommandType) {
+  MDMPlanCommandTypeAddPlan,
+  MDMPlanCommandTypeAddPlanNamed,
+  MDMPlanCommandTypeRemovePlanNamed,
+};
+
+/**
+ A runtime mutation submitted from an arbitrary thread.
+
+ The object pointers are retained while the command sits in the queue. plan is NULL for removals and
+ name, an MDMPlanName, is NULL for unnamed additions.
+ */
+typedef struct {
+  MDMPlanCommandType type;
+  const void *_Nullable plan;
+  const void *_Nonnull target;
+  const void *_Nullable name;
+} MDMPlanCommand;
+
+/** An object that executes plan commands on the queue's consumer thread. */
+@protocol MDMPlanCommandExecuting <NSObject>
+
+- (void)executePlanCommand:(nonnull const MDMPlanCommand *)command;
+
+@end
+
+/**
+ A lock-free multi-producer single-consumer queue of plan commands.
+
+ Enqueueing is safe from any thread and never blocks. Draining must only be performed by a single
+ consumer thread at a time. Commands are executed in the order in which their enqueue operations
+ were linked into the queue, so commands enqueued by one thread are always executed in that
+ thread's order.
+ */
+@interface MDMPlanCommandQueue : NSObject
+
+/**
+ Enqueues a command. The provided objects are retained until the command has been executed.
+
+ @return YES if the consumer should be scheduled to drain the queue. Only one enqueue returns YES
+         between two consecutive drains.
+ */
+- (BOOL)enqueueCommandOfType:(MDMPlanCommandType)type
+                        plan:(nullable id)plan
+                      target:(nonnull id)target
+                        name:(nullable MDMPlanName *)name;
+
+/**
+ Executes, in order, every command whose enqueue has completed. Consumer thread only.
+
+ A command may drain the queue again while it is being executed. The nested drain continues with
+ the commands after it, and the outer drain resumes after the last command the nested drain ran.
+ */
+- (void)drainToExecutor:(nonnull id<MDMPlanCommandExecuting>)executor;
+
+@end
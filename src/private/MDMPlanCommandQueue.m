@@ -0,0 +1,117 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMPlanCommandQueue.h"
+
+#import <stdatomic.h>
+#import <stdlib.h>
+
+// An intrusive node-based MPSC queue. Producers atomically swap themselves into the head and then
+// link the previous head to their node. The consumer walks from the tail, which always points at a
+// node whose command has already been taken for execution (initially a stub).
+typedef struct MDMPlanCommandNode {
+  _Atomic(struct MDMPlanCommandNode *) next;
+  MDMPlanCommand command;
+} MDMPlanCommandNode;
+
+static void releasePlanCommand(const MDMPlanCommand *command) {
+  if (command->plan) {
+    CFRelease(command->plan);
+  }
+  CFRelease(command->target);
+  if (command->name) {
+    CFRelease(command->name);
+  }
+}
+
+@implementation MDMPlanCommandQueue {
+  _Atomic(MDMPlanCommandNode *) _head;
+  MDMPlanCommandNode *_tail;
+  _Atomic(bool) _drainScheduled;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    MDMPlanCommandNode *stub = calloc(1, sizeof(MDMPlanCommandNode));
+    atomic_init(&_head, stub);
+    _tail = stub;
+    atomic_init(&_drainScheduled, false);
+  }
+  return self;
+}
+
+- (void)dealloc {
+  // The tail node's command has either been taken for execution or is the stub, so only its
+  // successors own objects.
+  MDMPlanCommandNode *node = _tail;
+  MDMPlanCommandNode *next = atomic_load_explicit(&node->next, memory_order_acquire);
+  free(node);
+  while (next) {
+    node = next;
+    next = atomic_load_explicit(&node->next, memory_order_acquire);
+    releasePlanCommand(&node->command);
+    free(node);
+  }
+}
+
+#pragma mark - Producers
+
+- (BOOL)enqueueCommandOfType:(MDMPlanCommandType)type
+                        plan:(id)plan
+                      target:(id)target
+                        name:(MDMPlanName *)name {
+  MDMPlanCommandNode *node = malloc(sizeof(MDMPlanCommandNode));
+  atomic_init(&node->next, NULL);
+  node->command.type = type;
+  node->command.plan = plan ? CFBridgingRetain(plan) : NULL;
+  node->command.target = CFBridgingRetain(target);
+  node->command.name = name ? CFBridgingRetain(name) : NULL;
+
+  MDMPlanCommandNode *previous = atomic_exchange_explicit(&_head, node, memory_order_acq_rel);
+  atomic_store_explicit(&previous->next, node, memory_order_release);
+
+  return !atomic_exchange_explicit(&_drainScheduled, true, memory_order_seq_cst);
+}
+
+#pragma mark - Consumer
+
+- (void)drainToExecutor:(id<MDMPlanCommandExecuting>)executor {
+  // Cleared before draining so that any command linked after this point schedules another drain.
+  atomic_store_explicit(&_drainScheduled, false, memory_order_seq_cst);
+
+  MDMPlanCommandNode *tail = _tail;
+  MDMPlanCommandNode *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+  // A NULL next while a producer is between its exchange and its link ends this drain early. That
+  // producer observes the cleared flag and schedules the next drain.
+  while (next) {
+    // Take the command and advance the tail before executing it. A drain started by the command
+    // itself then begins after it and may free its node.
+    MDMPlanCommand command = next->command;
+    _tail = next;
+    free(tail);
+
+    @autoreleasepool {
+      [executor executePlanCommand:&command];
+    }
+    releasePlanCommand(&command);
+
+    tail = _tail;
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+  }
+}
+
+@end
@@ -0,0 +1,33 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMPlan.h"
+
+/**
+ Returns the plan that the runtime should store for the given plan.
+
+ Immutable plans are returned as-is. All other plans are copied. Since an immutable plan instance
+ may be stored for many targets, anything keyed by plan, such as tokens, must also be keyed by
+ target.
+ */
+static inline id _Nonnull MDMRetainedCopyOfPlan(id<MDMPlan> _Nonnull plan) {
+  if ([plan conformsToProtocol:@protocol(MDMImmutablePlan)]) {
+    return plan;
+  }
+  return [plan copy];
+}
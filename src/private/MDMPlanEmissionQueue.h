@@ -0,0 +1,44 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@protocol MDMPlan;
+
+/**
+ A FIFO of plans emitted by composable performers, drained one generation at a time.
+
+ A generation consists of every plan in the queue when the drain begins. Plans enqueued while a
+ generation is being drained belong to the next generation.
+ */
+@interface MDMPlanEmissionQueue : NSObject
+
+/** Appends a plan to the queue. The plan and target are retained until the plan is drained. */
+- (void)enqueuePlan:(nonnull NSObject<MDMPlan> *)plan to:(nonnull id)target;
+
+/** Whether the queue holds no plans. */
+@property(nonatomic, assign, readonly, getter=isEmpty) BOOL empty;
+
+/**
+ Removes the current generation from the queue and invokes the block once per target.
+
+ Targets are visited in order of their first plan in the generation. Each invocation receives the
+ target's plans in the order in which they were enqueued.
+ */
+- (void)drainGenerationUsingBlock:
+    (void (^_Nonnull)(id _Nonnull target, NSArray<NSObject<MDMPlan> *> *_Nonnull plans))block;
+
+@end
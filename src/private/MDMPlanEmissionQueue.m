@@ -0,0 +1,68 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMPlanEmissionQueue.h"
+
+#import "MDMPlan.h"
+
+@implementation MDMPlanEmissionQueue {
+  // Targets in order of their first plan in the current generation.
+  NSMutableArray *_targets;
+  NSMapTable<id, NSMutableArray<NSObject<MDMPlan> *> *> *_targetToPlans;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _targets = [NSMutableArray array];
+    _targetToPlans = [NSMapTable
+        mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory
+                                | NSPointerFunctionsObjectPointerPersonality)
+                  valueOptions:NSPointerFunctionsStrongMemory];
+  }
+  return self;
+}
+
+- (BOOL)isEmpty {
+  return _targets.count == 0;
+}
+
+- (void)enqueuePlan:(NSObject<MDMPlan> *)plan to:(id)target {
+  NSMutableArray<NSObject<MDMPlan> *> *plans = [_targetToPlans objectForKey:target];
+  if (!plans) {
+    plans = [NSMutableArray arrayWithObject:plan];
+    [_targetToPlans setObject:plans forKey:target];
+    [_targets addObject:target];
+    return;
+  }
+  [plans addObject:plan];
+}
+
+- (void)drainGenerationUsingBlock:(void (^)(id, NSArray<NSObject<MDMPlan> *> *))block {
+  NSArray *targets = _targets;
+  NSMapTable<id, NSMutableArray<NSObject<MDMPlan> *> *> *targetToPlans = _targetToPlans;
+  _targets = [NSMutableArray array];
+  _targetToPlans = [NSMapTable
+      mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory
+                              | NSPointerFunctionsObjectPointerPersonality)
+                valueOptions:NSPointerFunctionsStrongMemory];
+
+  for (id target in targets) {
+    block(target, [targetToPlans objectForKey:target]);
+  }
+}
+
+@end
@@ -24,6 +24,14 @@
 - (nonnull instancetype)initWithTargetRegistry:(nonnull MDMTargetRegistry *)targetRegistry
                                         target:(nonnull id)target;
 
+/**
+ The target to which plans are emitted.
+
+ Set to nil when the owning scope is retired. Each attachment of a scope to a target uses a new
+ emitter, so emissions from performers that outlive their scope are dropped.
+ */
+@property(nonatomic, weak, nullable) id target;
+
 - (nonnull instancetype)init NS_UNAVAILABLE;
 + (nonnull instancetype) new NS_UNAVAILABLE;
 
@@ -16,13 +16,12 @@
 
 #import "MDMPlanEmitter.h"
 
-#import "MDMMotionRuntime.h"
+#import "MDMMotionRuntime+Private.h"
 #import "MDMTargetRegistry.h"
 
 @interface MDMPlanEmitter ()
 
 @property(nonatomic, weak) MDMTargetRegistry *targetRegistry;
-@property(nonatomic, weak) id target;
 
 @end
 
@@ -45,7 +44,7 @@
   if (!registry || !target) {
     return;
   }
-  [registry.runtime addPlan:plan to:target];
+  [registry.runtime emitPlan:plan to:target];
 }
 
 @end
@@ -0,0 +1,33 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMPlanName.h"
+
+@interface MDMPlanName ()
+
+/**
+ Returns the handle for the given non-empty string without making it permanent. Thread-safe.
+
+ The handle is shared with every other live handle for the string, but it is deallocated once
+ nothing retains it. Holders that key state by the handle's identifier must retain the handle for
+ as long as the state exists.
+ */
++ (nonnull instancetype)transientPlanNameWithString:(nonnull NSString *)string;
+
+/** Whether the handle was returned by planNameWithString: and will never be deallocated. */
+@property(nonatomic, assign, readonly, getter=isPermanent) BOOL permanent;
+
+@end
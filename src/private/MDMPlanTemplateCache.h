@@ -0,0 +1,45 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@protocol MDMPlan;
+@protocol MDMReplayablePlan;
+
+/**
+ Maps replayable plans to the plans their performers emitted when they were first added.
+
+ Plans are matched with isEqual: and hash. The cache holds a bounded number of templates; once it
+ is full, further templates are not recorded until the cache is invalidated.
+ */
+@interface MDMPlanTemplateCache : NSObject
+
+/** Returns the recorded template for an equal plan, or nil. */
+- (nullable NSArray<NSObject<MDMPlan> *> *)templateForPlan:(nonnull id<MDMReplayablePlan>)plan;
+
+/** Stores the template for the plan. Does nothing if the cache is full. */
+- (void)setTemplate:(nonnull NSArray<NSObject<MDMPlan> *> *)plans
+            forPlan:(nonnull id<MDMReplayablePlan>)plan;
+
+/** Removes the templates of every plan of the given class. */
+- (void)removeTemplatesForPlanClass:(nonnull Class)planClass;
+
+- (void)removeAllTemplates;
+
+/** The number of stored templates. */
+@property(nonatomic, assign, readonly) NSUInteger count;
+
+@end
@@ -0,0 +1,66 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMPlanTemplateCache.h"
+
+#import "MDMPlan.h"
+
+// The maximum number of templates held by a cache.
+static const NSUInteger kMaxTemplateCount = 256;
+
+@implementation MDMPlanTemplateCache {
+  NSMutableDictionary<id<MDMReplayablePlan>, NSArray<NSObject<MDMPlan> *> *> *_planToTemplate;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _planToTemplate = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (NSUInteger)count {
+  return _planToTemplate.count;
+}
+
+- (NSArray<NSObject<MDMPlan> *> *)templateForPlan:(id<MDMReplayablePlan>)plan {
+  return _planToTemplate[plan];
+}
+
+- (void)setTemplate:(NSArray<NSObject<MDMPlan> *> *)plans forPlan:(id<MDMReplayablePlan>)plan {
+  if (_planToTemplate.count >= kMaxTemplateCount && !_planToTemplate[plan]) {
+    return;
+  }
+  // The key is copied by the dictionary, so later mutations of the added plan can't affect it.
+  _planToTemplate[plan] = [plans copy];
+}
+
+- (void)removeTemplatesForPlanClass:(Class)planClass {
+  NSMutableArray<id<MDMReplayablePlan>> *keys = [NSMutableArray array];
+  for (id<MDMReplayablePlan> plan in _planToTemplate) {
+    if ([plan isMemberOfClass:planClass]) {
+      [keys addObject:plan];
+    }
+  }
+  [_planToTemplate removeObjectsForKeys:keys];
+}
+
+- (void)removeAllTemplates {
+  [_planToTemplate removeAllObjects];
+}
+
+@end
@@ -0,0 +1,50 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMRuntimeSnapshot.h"
+
+@interface MDMRuntimeTargetSnapshot ()
+
+- (nonnull instancetype)initWithTarget:(nonnull id)target;
+
+@property(nonatomic, assign) NSUInteger performerCount;
+@property(nonatomic, assign) NSUInteger namedPlanCount;
+@property(nonatomic, assign) NSUInteger activeTokenCount;
+@property(nonatomic, assign) NSUInteger estimatedByteCount;
+
+@end
+
+@interface MDMRuntimeSnapshot ()
+
+- (nonnull instancetype)initInternal;
+
+@property(nonatomic, assign) NSUInteger targetScopeCount;
+@property(nonatomic, assign) NSUInteger performerCount;
+@property(nonatomic, assign) NSUInteger tokenCount;
+@property(nonatomic, assign) NSUInteger activeTokenCount;
+@property(nonatomic, assign) NSUInteger namedPlanCount;
+@property(nonatomic, assign) NSUInteger retainedPlanCount;
+@property(nonatomic, assign) NSUInteger tracerCount;
+@property(nonatomic, assign) NSUInteger estimatedByteCount;
+@property(nonatomic, copy, nonnull) NSDictionary<NSString *, NSNumber *> *performerCountByClassName;
+@property(nonatomic, copy, nonnull)
+    NSDictionary<NSString *, NSNumber *> *estimatedPerformerByteCountByClassName;
+@property(nonatomic, copy, nullable) NSArray<MDMRuntimeTargetSnapshot *> *targets;
+@property(nonatomic, assign) NSUInteger peakTargetScopeCount;
+@property(nonatomic, assign) NSUInteger peakPerformerCount;
+@property(nonatomic, assign) NSUInteger peakActiveTokenCount;
+
+@end
@@ -0,0 +1,56 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMTimeline.h"
+
+/**
+ Stores pre-sampled timeline curves in one contiguous buffer and resolves all of them for a time
+ offset in a single pass.
+
+ Each curve is sampled at evenly spaced offsets over [0, duration], with the density given by
+ sampleRate, the first time it is resolved and again after it has been invalidated. Resolving
+ interpolates linearly between the two samples nearest to the offset and clamps offsets outside of
+ the curve's duration.
+ */
+@interface MDMSampledCurveTable : NSObject
+
+/** Samples per second of curve duration. Changing the rate resamples every curve. */
+@property(nonatomic, assign) double sampleRate;
+
+/** The number of registered curves. */
+@property(nonatomic, assign, readonly) NSUInteger count;
+
+- (void)addCurve:(nonnull MDMTimelineCurve)curve
+        duration:(NSTimeInterval)duration
+       forTarget:(nonnull id)target
+         applier:(nonnull MDMTimelineCurveApplier)applier;
+
+/** Removes every curve registered for the target. */
+- (void)removeCurvesForTarget:(nonnull id)target;
+
+/** Resamples the target's curves the next time they are resolved. */
+- (void)invalidateCurvesForTarget:(nonnull id)target;
+
+/**
+ Resolves every curve at the time offset and passes each value to its curve's applier.
+
+ Curves whose targets have been deallocated are removed.
+ */
+- (void)applyValuesAtTimeOffset:(NSTimeInterval)timeOffset;
+
+@end
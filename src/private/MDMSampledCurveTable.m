@@ -0,0 +1,250 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMSampledCurveTable.h"
+
+#import <math.h>
+#import <stdlib.h>
+#import <string.h>
+
+static const double kDefaultSampleRate = 240;
+
+/** A registered curve and the location of its samples. */
+@interface MDMSampledCurve : NSObject
+@end
+
+@implementation MDMSampledCurve {
+ @package
+  MDMTimelineCurve _curve;
+  MDMTimelineCurveApplier _applier;
+  __weak id _target;
+  NSTimeInterval _duration;
+
+  // The index of the curve's first sample in the table's sample buffer.
+  NSUInteger _offset;
+  // The number of samples over [0, duration]. One padding sample follows.
+  NSUInteger _sampleCount;
+  BOOL _needsSampling;
+}
+@end
+
+// Interpolates every curve at the offset. Curve c's samples begin at samples + offsets[c] and are
+// followed by a copy of the last sample, so index + 1 is always in bounds.
+static void resolveCurves(const double *samples, const NSUInteger *offsets, const double *scales,
+                          const double *lastIndices, NSUInteger count, NSTimeInterval timeOffset,
+                          double *values) {
+  for (NSUInteger c = 0; c < count; c++) {
+    double position = fmin(fmax(timeOffset * scales[c], 0), lastIndices[c]);
+    NSUInteger index = (NSUInteger)position;
+    double fraction = position - (double)index;
+    const double *table = samples + offsets[c];
+    values[c] = table[index] + (table[index + 1] - table[index]) * fraction;
+  }
+}
+
+@implementation MDMSampledCurveTable {
+  NSMutableArray<MDMSampledCurve *> *_curves;
+  NSMapTable<id, NSMutableArray<MDMSampledCurve *> *> *_targetToCurves;
+
+  double *_samples;
+
+  // Per-curve resolution inputs and outputs, indexed like _curves.
+  NSUInteger *_offsets;
+  double *_scales;
+  double *_lastIndices;
+  double *_values;
+
+  // Set when curves are added or removed or the sample rate changes.
+  BOOL _needsLayout;
+  BOOL _needsSampling;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _sampleRate = kDefaultSampleRate;
+    _curves = [NSMutableArray array];
+    _targetToCurves = [NSMapTable weakToStrongObjectsMapTable];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_samples);
+  free(_offsets);
+  free(_scales);
+  free(_lastIndices);
+  free(_values);
+}
+
+- (NSUInteger)count {
+  return _curves.count;
+}
+
+- (void)setSampleRate:(double)sampleRate {
+  NSParameterAssert(sampleRate > 0);
+  if (_sampleRate == sampleRate) {
+    return;
+  }
+  _sampleRate = sampleRate;
+  for (MDMSampledCurve *curve in _curves) {
+    curve->_needsSampling = YES;
+  }
+  _needsLayout = YES;
+  _needsSampling = YES;
+}
+
+- (void)addCurve:(MDMTimelineCurve)curve
+        duration:(NSTimeInterval)duration
+       forTarget:(id)target
+         applier:(MDMTimelineCurveApplier)applier {
+  NSParameterAssert(duration >= 0);
+  MDMSampledCurve *sampledCurve = [MDMSampledCurve new];
+  sampledCurve->_curve = [curve copy];
+  sampledCurve->_applier = [applier copy];
+  sampledCurve->_target = target;
+  sampledCurve->_duration = duration;
+  sampledCurve->_needsSampling = YES;
+  [_curves addObject:sampledCurve];
+
+  NSMutableArray<MDMSampledCurve *> *targetCurves = [_targetToCurves objectForKey:target];
+  if (!targetCurves) {
+    targetCurves = [NSMutableArray array];
+    [_targetToCurves setObject:targetCurves forKey:target];
+  }
+  [targetCurves addObject:sampledCurve];
+
+  _needsLayout = YES;
+  _needsSampling = YES;
+}
+
+- (void)removeCurvesForTarget:(id)target {
+  NSMutableArray<MDMSampledCurve *> *targetCurves = [_targetToCurves objectForKey:target];
+  if (!targetCurves) {
+    return;
+  }
+  [_targetToCurves removeObjectForKey:target];
+  [_curves removeObjectsInArray:targetCurves];
+  _needsLayout = YES;
+}
+
+- (void)invalidateCurvesForTarget:(id)target {
+  for (MDMSampledCurve *curve in [_targetToCurves objectForKey:target]) {
+    curve->_needsSampling = YES;
+    _needsSampling = YES;
+  }
+}
+
+- (void)applyValuesAtTimeOffset:(NSTimeInterval)timeOffset {
+  if (_needsLayout) {
+    [self layOutSamples];
+  }
+  if (_needsSampling) {
+    [self sampleCurves];
+  }
+  NSUInteger count = _curves.count;
+  if (count == 0) {
+    return;
+  }
+
+  resolveCurves(_samples, _offsets, _scales, _lastIndices, count, timeOffset, _values);
+
+  // Appliers may add or remove curves, so the curves are copied first.
+  NSArray<MDMSampledCurve *> *curves = [_curves copy];
+  BOOL foundReleasedTarget = NO;
+  for (NSUInteger c = 0; c < count; c++) {
+    MDMSampledCurve *curve = curves[c];
+    id target = curve->_target;
+    if (!target) {
+      foundReleasedTarget = YES;
+      continue;
+    }
+    curve->_applier(target, _values[c]);
+  }
+
+  if (foundReleasedTarget) {
+    NSIndexSet *released = [_curves indexesOfObjectsPassingTest:^BOOL(MDMSampledCurve *curve,
+                                                                      NSUInteger index,
+                                                                      BOOL *stop) {
+      return curve->_target == nil;
+    }];
+    [_curves removeObjectsAtIndexes:released];
+    _needsLayout = YES;
+  }
+}
+
+#pragma mark - Private
+
+// Assigns every curve a contiguous range of the sample buffer. Samples of curves that don't need
+// sampling are carried over from the previous buffer.
+- (void)layOutSamples {
+  NSUInteger count = _curves.count;
+  _offsets = realloc(_offsets, MAX(count, (NSUInteger)1) * sizeof(NSUInteger));
+  _scales = realloc(_scales, MAX(count, (NSUInteger)1) * sizeof(double));
+  _lastIndices = realloc(_lastIndices, MAX(count, (NSUInteger)1) * sizeof(double));
+  _values = realloc(_values, MAX(count, (NSUInteger)1) * sizeof(double));
+
+  NSUInteger totalSampleCount = 0;
+  for (NSUInteger c = 0; c < count; c++) {
+    MDMSampledCurve *curve = _curves[c];
+    NSUInteger sampleCount = (NSUInteger)ceil(curve->_duration * _sampleRate) + 1;
+    if (sampleCount != curve->_sampleCount) {
+      curve->_needsSampling = YES;
+      _needsSampling = YES;
+    }
+    curve->_sampleCount = sampleCount;
+    totalSampleCount += sampleCount + 1;
+
+    double lastIndex = (double)(sampleCount - 1);
+    _lastIndices[c] = lastIndex;
+    _scales[c] = curve->_duration > 0 ? lastIndex / curve->_duration : 0;
+  }
+
+  double *samples = malloc(MAX(totalSampleCount, (NSUInteger)1) * sizeof(double));
+  NSUInteger offset = 0;
+  for (NSUInteger c = 0; c < count; c++) {
+    MDMSampledCurve *curve = _curves[c];
+    if (!curve->_needsSampling) {
+      memcpy(samples + offset, _samples + curve->_offset,
+             (curve->_sampleCount + 1) * sizeof(double));
+    }
+    curve->_offset = offset;
+    _offsets[c] = offset;
+    offset += curve->_sampleCount + 1;
+  }
+  free(_samples);
+  _samples = samples;
+  _needsLayout = NO;
+}
+
+- (void)sampleCurves {
+  for (MDMSampledCurve *curve in _curves) {
+    if (!curve->_needsSampling) {
+      continue;
+    }
+    double *table = _samples + curve->_offset;
+    NSUInteger lastIndex = curve->_sampleCount - 1;
+    double interval = lastIndex > 0 ? curve->_duration / (double)lastIndex : 0;
+    for (NSUInteger index = 0; index <= lastIndex; index++) {
+      table[index] = curve->_curve(interval * (double)index);
+    }
+    table[lastIndex + 1] = table[lastIndex];
+    curve->_needsSampling = NO;
+  }
+  _needsSampling = NO;
+}
+
+@end
@@ -16,16 +16,21 @@
 
 #import <Foundation/Foundation.h>
 
-@class MDMTokenPool;
+@class MDMFrameScheduler;
 @class MDMMotionRuntime;
+@class MDMMotionSolver;
+@class MDMPerformerBudget;
+@class MDMPlanName;
+@class MDMRuntimeSnapshot;
+@class MDMTargetScope;
+@class MDMTracerTable;
 @protocol MDMPlan;
 @protocol MDMNamedPlan;
-@protocol MDMTracing;
 
 @interface MDMTargetRegistry : NSObject
 
 - (nonnull instancetype)initWithRuntime:(nonnull MDMMotionRuntime *)runtime
-                                tracers:(nonnull NSOrderedSet<id<MDMTracing>> *)tracers
+                                tracers:(nonnull MDMTracerTable *)tracers
     NS_DESIGNATED_INITIALIZER;
 
 - (nonnull instancetype)init NS_UNAVAILABLE;
@@ -33,14 +38,46 @@
 
 @property(nonatomic, weak, nullable, readonly) MDMMotionRuntime *runtime;
 
-@property(nonatomic, strong, nonnull, readonly) MDMTokenPool *tokenPool;
+/** Shared by every target scope of the registry. */
+@property(nonatomic, strong, nonnull, readonly) MDMPerformerBudget *performerBudget;
 
-- (void)addPlan:(nonnull NSObject<MDMPlan> *)plan to:(nonnull id)target;
+/** Given to every frame-scheduled performer created by the registry's scopes. */
+@property(nonatomic, strong, nonnull, readonly) MDMFrameScheduler *frameScheduler;
 
-- (void)addPlan:(nonnull id<MDMNamedPlan>)plan
-          named:(nonnull NSString *)name
-             to:(nonnull id)target;
-- (void)removePlanNamed:(nonnull NSString *)name
+/** Integrates the springs and tweens of every target. Steps with frameScheduler. */
+@property(nonatomic, strong, nonnull, readonly) MDMMotionSolver *motionSolver;
+
+/** The largest number of scopes the registry has held at once. */
+@property(nonatomic, assign, readonly) NSUInteger peakScopeCount;
+
+/** Returns the scope for the given target, creating one if needed. */
+- (nonnull MDMTargetScope *)scopeForTarget:(nonnull id)target;
+
+/** Returns the scope for the given target if one exists. Never allocates. */
+- (nullable MDMTargetScope *)existingScopeForTarget:(nonnull id)target;
+
+/**
+ Removes a named plan from the target's scope, if the target has one. Never allocates a scope.
+
+ Reclaims the scope if it becomes idle.
+ */
+- (void)removePlanNamed:(nonnull MDMPlanName *)name
                    from:(nonnull id)target;
 
+/**
+ Retires the scope and returns it to the free list if the scope is idle.
+
+ A later plan addition for the same target receives a fresh scope.
+ */
+- (void)reclaimScopeIfIdle:(nonnull MDMTargetScope *)scope;
+
+/**
+ Records the registry's scope, performer, token and named plan counts into the snapshot.
+
+ Visits every scope once. Allocates one MDMRuntimeTargetSnapshot per scope if includingTargets is
+ YES.
+ */
+- (void)populateSnapshot:(nonnull MDMRuntimeSnapshot *)snapshot
+        includingTargets:(BOOL)includingTargets;
+
 @end
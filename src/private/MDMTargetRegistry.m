@@ -16,58 +16,188 @@
 
 #import "MDMTargetRegistry.h"
 
+#import <objc/runtime.h>
+
+#import "MDMFrameScheduler.h"
+#import "MDMMotionSolver.h"
+#import "MDMPerformerBudget.h"
+#import "MDMPerformerDescriptor.h"
 #import "MDMPlanEmitter.h"
+#import "MDMRuntimeSnapshot+Private.h"
 #import "MDMTargetScope.h"
-#import "MDMTokenPool.h"
+#import "MDMToken.h"
+
+// The maximum number of reclaimed scopes kept for reuse.
+static const NSUInteger kMaxFreeScopeCount = 32;
 
 @implementation MDMTargetRegistry {
   NSMapTable<id, MDMTargetScope *> *_targetToScope;
-  NSOrderedSet<id<MDMTracing>> *_tracers;
+  NSMutableArray<MDMTargetScope *> *_freeScopes;
+  MDMTracerTable *_tracers;
+  MDMPerformerDescriptorTable *_performerDescriptors;
 }
 
 - (instancetype)initWithRuntime:(nonnull MDMMotionRuntime *)runtime
-                        tracers:(nonnull NSOrderedSet<id<MDMTracing>> *)tracers {
+                        tracers:(nonnull MDMTracerTable *)tracers {
   self = [super init];
   if (self) {
     _runtime = runtime;
     _tracers = tracers;
 
     _targetToScope = [NSMapTable weakToStrongObjectsMapTable];
-    _tokenPool = [MDMTokenPool new];
+    _freeScopes = [NSMutableArray arrayWithCapacity:kMaxFreeScopeCount];
+    _performerDescriptors = [MDMPerformerDescriptorTable new];
+    _performerBudget = [MDMPerformerBudget new];
+    _frameScheduler = [MDMFrameScheduler new];
+    _motionSolver = [[MDMMotionSolver alloc] initWithFrameScheduler:_frameScheduler];
   }
   return self;
 }
 
-#pragma mark - Private
+#pragma mark - Public
+
+- (MDMTargetScope *)existingScopeForTarget:(id)target {
+  return [_targetToScope objectForKey:target];
+}
 
 - (MDMTargetScope *)scopeForTarget:(id)target {
   MDMTargetScope *scope = [_targetToScope objectForKey:target];
+  if (!scope && _freeScopes.count > 0) {
+    scope = _freeScopes.lastObject;
+    [_freeScopes removeLastObject];
+    [scope attachToTarget:target
+              planEmitter:[[MDMPlanEmitter alloc] initWithTargetRegistry:self target:target]];
+    [self insertScope:scope forTarget:target];
+  }
   if (!scope) {
     MDMPlanEmitter *emitter = [[MDMPlanEmitter alloc] initWithTargetRegistry:self target:target];
     scope = [[MDMTargetScope alloc] initWithTarget:target
                                            tracers:_tracers
+                              performerDescriptors:_performerDescriptors
                                        planEmitter:emitter
-                                         tokenPool:_tokenPool];
-    [_targetToScope setObject:scope forKey:target];
+                                   performerBudget:_performerBudget
+                                    frameScheduler:_frameScheduler
+                                      motionSolver:_motionSolver];
+    [self insertScope:scope forTarget:target];
   }
 
   return scope;
 }
 
-#pragma mark - Public
+- (void)removePlanNamed:(MDMPlanName *)name from:(id)target {
+  MDMTargetScope *scope = [_targetToScope objectForKey:target];
+  if (!scope) {
+    return;
+  }
+  [scope removePlanNamed:name from:target];
+  [self reclaimScopeIfIdle:scope];
+}
 
-- (void)addPlan:(NSObject<MDMPlan> *)plan to:(id)target {
-  [[self scopeForTarget:target] addPlan:plan to:target];
+- (void)reclaimScopeIfIdle:(MDMTargetScope *)scope {
+  id target = scope.target;
+  if (!scope.isIdle || !target || [_targetToScope objectForKey:target] != scope) {
+    return;
+  }
+  [_targetToScope removeObjectForKey:target];
+  [scope retire];
+  if (_freeScopes.count < kMaxFreeScopeCount) {
+    [_freeScopes addObject:scope];
+  }
 }
 
-- (void)addPlan:(NSObject<MDMNamedPlan> *)plan named:(NSString *)name to:(id)target {
-  NSParameterAssert(name.length > 0);
-  [[self scopeForTarget:target] addPlan:plan named:name to:target];
+- (void)populateSnapshot:(MDMRuntimeSnapshot *)snapshot includingTargets:(BOOL)includingTargets {
+  // Estimated per-scope overhead: the scope, its plan emitter and its entries.
+  const NSUInteger scopeByteCount = (NSUInteger)(class_getInstanceSize([MDMTargetScope class])
+                                                 + class_getInstanceSize([MDMPlanEmitter class]));
+  const NSUInteger entryByteCount = (NSUInteger)class_getInstanceSize([MDMPerformerEntry class]);
+  // A named plan costs one key and one value in its scope's map table.
+  const NSUInteger namedPlanByteCount = 2 * sizeof(void *);
+
+  NSMapTable<Class, NSNumber *> *classToCount = [NSMapTable strongToStrongObjectsMapTable];
+  NSMutableArray<MDMRuntimeTargetSnapshot *> *targets =
+      includingTargets ? [NSMutableArray array] : nil;
+
+  __block NSUInteger performerCount = 0;
+  NSUInteger scopeCount = 0;
+  NSUInteger namedPlanCount = 0;
+  NSUInteger tokenCount = 0;
+  __block NSUInteger retainedPlanCount = 0;
+  NSUInteger byteCount = 0;
+  for (id target in _targetToScope) {
+    MDMTargetScope *scope = [_targetToScope objectForKey:target];
+    if (!target || !scope) {
+      continue;
+    }
+    scopeCount++;
+
+    __block NSUInteger scopePerformerCount = 0;
+    __block NSUInteger scopeByteTotal = scopeByteCount;
+    [scope enumeratePerformersUsingBlock:^(id<MDMPerforming> performer) {
+      Class performerClass = [performer class];
+      NSNumber *count = [classToCount objectForKey:performerClass];
+      [classToCount setObject:@(count.unsignedIntegerValue + 1) forKey:performerClass];
+      scopePerformerCount++;
+      scopeByteTotal += (NSUInteger)class_getInstanceSize(performerClass) + entryByteCount;
+    }];
+    // Retained plans are owned by the scope alone while their performer is evicted.
+    [scope enumerateRetainedPlansUsingBlock:^(id<MDMPlan> plan) {
+      retainedPlanCount++;
+      scopeByteTotal += (NSUInteger)class_getInstanceSize([plan class]) + sizeof(void *);
+    }];
+    NSUInteger scopeNamedPlanCount = scope.namedPlanCount;
+    scopeByteTotal += scopeNamedPlanCount * namedPlanByteCount;
+
+    performerCount += scopePerformerCount;
+    namedPlanCount += scopeNamedPlanCount;
+    tokenCount += scope.tokenCount;
+    byteCount += scopeByteTotal;
+
+    if (targets) {
+      MDMRuntimeTargetSnapshot *targetSnapshot =
+          [[MDMRuntimeTargetSnapshot alloc] initWithTarget:target];
+      targetSnapshot.performerCount = scopePerformerCount;
+      targetSnapshot.namedPlanCount = scopeNamedPlanCount;
+      targetSnapshot.activeTokenCount = scope.activeTokenCount;
+      targetSnapshot.estimatedByteCount = scopeByteTotal;
+      [targets addObject:targetSnapshot];
+    }
+  }
+
+  NSMutableDictionary<NSString *, NSNumber *> *countByClassName =
+      [NSMutableDictionary dictionaryWithCapacity:classToCount.count];
+  NSMutableDictionary<NSString *, NSNumber *> *bytesByClassName =
+      [NSMutableDictionary dictionaryWithCapacity:classToCount.count];
+  for (Class performerClass in classToCount) {
+    NSUInteger count = [classToCount objectForKey:performerClass].unsignedIntegerValue;
+    NSString *className = NSStringFromClass(performerClass);
+    countByClassName[className] = @(count);
+    bytesByClassName[className] = @(count * (NSUInteger)class_getInstanceSize(performerClass));
+  }
+
+  byteCount += tokenCount * (NSUInteger)class_getInstanceSize([MDMToken class]);
+  byteCount += _freeScopes.count * scopeByteCount;
+
+  _peakScopeCount = MAX(_peakScopeCount, scopeCount);
+
+  snapshot.targetScopeCount = scopeCount;
+  snapshot.performerCount = performerCount;
+  snapshot.tokenCount = tokenCount;
+  snapshot.namedPlanCount = namedPlanCount;
+  snapshot.retainedPlanCount = retainedPlanCount;
+  snapshot.estimatedByteCount = byteCount;
+  snapshot.performerCountByClassName = countByClassName;
+  snapshot.estimatedPerformerByteCountByClassName = bytesByClassName;
+  snapshot.targets = targets;
+  snapshot.peakTargetScopeCount = _peakScopeCount;
+  snapshot.peakPerformerCount = _performerBudget.peakLivePerformerCount;
 }
 
-- (void)removePlanNamed:(NSString *)name from:(id)target {
-  NSParameterAssert(name.length > 0);
-  [[self scopeForTarget:target] removePlanNamed:name from:target];
+#pragma mark - Private
+
+- (void)insertScope:(MDMTargetScope *)scope forTarget:(id)target {
+  [_targetToScope setObject:scope forKey:target];
+  // The count may include scopes of deallocated targets that the map table has yet to purge.
+  _peakScopeCount = MAX(_peakScopeCount, _targetToScope.count);
 }
 
 @end
@@ -16,27 +16,120 @@
 
 #import <Foundation/Foundation.h>
 
-@class MDMTokenPool;
+@class MDMFrameScheduler;
+@class MDMMotionSolver;
+@class MDMPerformerBudget;
+@class MDMPerformerDescriptorTable;
+@class MDMPerformerEntry;
 @class MDMPlanEmitter;
+@class MDMPlanName;
+@class MDMTokenPool;
+@class MDMTracerTable;
 @protocol MDMPlan;
+@protocol MDMEquatablePlan;
 @protocol MDMNamedPlan;
-@protocol MDMTracing;
+@protocol MDMPerforming;
 
 /** An entity responsible for managing the performers associated with a given target. */
 @interface MDMTargetScope : NSObject
 
 - (nonnull instancetype)initWithTarget:(nonnull id)target
-                               tracers:(nonnull NSOrderedSet<id<MDMTracing>> *)tracers
+                               tracers:(nonnull MDMTracerTable *)tracers
+                  performerDescriptors:(nonnull MDMPerformerDescriptorTable *)performerDescriptors
                            planEmitter:(nonnull MDMPlanEmitter *)planEmitter
-                             tokenPool:(nonnull MDMTokenPool *)tokenPool
+                       performerBudget:(nonnull MDMPerformerBudget *)performerBudget
+                        frameScheduler:(nonnull MDMFrameScheduler *)frameScheduler
+                          motionSolver:(nonnull MDMMotionSolver *)motionSolver
     NS_DESIGNATED_INITIALIZER;
 
 - (nonnull instancetype)init NS_UNAVAILABLE;
 + (nonnull instancetype) new NS_UNAVAILABLE;
 
+/** The target whose performers this scope manages. */
+@property(nonatomic, weak, nullable, readonly) id target;
+
+/**
+ Generates the tokens for plans added to this scope's target.
+
+ Each scope has its own pool so that an immutable plan instance added to several targets receives
+ a distinct token per target. Replaced when the scope is retired.
+ */
+@property(nonatomic, strong, nonnull, readonly) MDMTokenPool *tokenPool;
+
+/** The number of tokens generated by the scope's token pool whose plans are still alive. */
+@property(nonatomic, assign, readonly) NSUInteger tokenCount;
+
+/** The number of currently active tokens whose plans were added to this scope's target. */
+@property(nonatomic, assign, readonly) NSUInteger activeTokenCount;
+
+/** The number of named plans currently added to this scope's target. */
+@property(nonatomic, assign, readonly) NSUInteger namedPlanCount;
+
+/** Invokes the block for each live performer of the scope, in slot order. */
+- (void)enumeratePerformersUsingBlock:(void (^_Nonnull)(id<MDMPerforming> _Nonnull performer))block;
+
+/** Invokes the block for each plan retained to rehydrate an evicted performer. */
+- (void)enumerateRetainedPlansUsingBlock:(void (^_Nonnull)(id<MDMPlan> _Nonnull plan))block;
+
+/** Records that count tokens for plans of the performer in the given slot became active. */
+- (void)didActivateTokenCount:(NSUInteger)count forPerformerSlot:(NSUInteger)slot;
+
+/** Records that count tokens for plans of the performer in the given slot became inactive. */
+- (void)didDeactivateTokenCount:(NSUInteger)count forPerformerSlot:(NSUInteger)slot;
+
+/**
+ Releases the entry's performer. The entry keeps its retained plans for rehydration.
+
+ Invoked by the performer budget. The performer is released when the current autorelease pool
+ drains.
+ */
+- (void)evictPerformerOfEntry:(nonnull MDMPerformerEntry *)entry;
+
+/**
+ Incremented each time the scope is retired.
+
+ Objects that weakly reference a scope store the generation they observed so that they can detect
+ that the scope now represents a different target.
+ */
+@property(nonatomic, assign, readonly) NSUInteger generation;
+
+/** Whether the scope has no named plans, has never received unnamed plans and has no active tokens. */
+@property(nonatomic, assign, readonly, getter=isIdle) BOOL idle;
+
+/**
+ Detaches the scope from its target and releases its performers and named plans.
+
+ The performers are released when the current autorelease pool drains, since they may still be
+ executing when their scope is retired.
+ */
+- (void)retire;
+
+/**
+ Associates a retired scope with a new target.
+
+ The scope's new performers are given the provided emitter. The emitter of the scope's previous
+ target was disconnected on retirement, so that performers that outlive the retired scope can't
+ emit plans to the new target.
+ */
+- (void)attachToTarget:(nonnull id)target planEmitter:(nonnull MDMPlanEmitter *)planEmitter;
+
 - (void)addPlan:(nonnull id<MDMPlan>)plan to:(nonnull id)target;
+- (void)addPlans:(nonnull NSArray<id<MDMPlan>> *)plans to:(nonnull id)target;
+
+- (void)addPlan:(nonnull id<MDMNamedPlan>)plan
+          named:(nonnull MDMPlanName *)name
+             to:(nonnull id)target;
+- (void)removePlanNamed:(nonnull MDMPlanName *)name from:(nonnull id)target;
+
+#pragma mark Deduplication
+
+/**
+ Returns YES if a plan equal to the given plan was remembered by this scope, in which case the
+ plan's performer is also marked as recently used.
+ */
+- (BOOL)touchEquatablePlan:(nonnull id<MDMEquatablePlan>)plan;
 
-- (void)addPlan:(nonnull id<MDMNamedPlan>)plan named:(nonnull NSString *)name to:(nonnull id)target;
-- (void)removePlanNamed:(nonnull NSString *)name from:(nonnull id)target;
+/** Remembers an added plan so that later equal plans can be recognized. */
+- (void)rememberEquatablePlan:(nonnull id<MDMEquatablePlan>)plan;
 
 @end
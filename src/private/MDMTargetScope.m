@@ -16,143 +16,505 @@
 
 #import "MDMTargetScope.h"
 
+#import "MDMFrameScheduler.h"
+#import "MDMPerformerBudget.h"
+#import "MDMPerformerDescriptor.h"
+#import "MDMPerformerLatencyRecorder+Private.h"
+#import "MDMMonotonicTime.h"
+#import "MDMMotionSolver.h"
 #import "MDMPlan.h"
+#import "MDMPlanName+Private.h"
 #import "MDMPlanEmitter.h"
 #import "MDMTokenPool.h"
-#import "MDMTracing.h"
+#import "MDMTracerTable.h"
+
+// Times a performer callback. Callers invoke the performer directly when the runtime has no latency
+// recorder, so that untimed callbacks don't pay for a block.
+static inline void timePerformerCallback(MDMPerformerCallback callback,
+                                         MDMPerformerDescriptor *descriptor,
+                                         MDMPerformerLatencyRecorder *recorder,
+                                         NS_NOESCAPE void (^invocation)(void)) {
+  uint64_t start = MDMMonotonicTimeNanoseconds();
+  invocation();
+  uint64_t end = MDMMonotonicTimeNanoseconds();
+  [recorder recordNanoseconds:end - start
+                   ofCallback:callback
+                performerSlot:descriptor.slot
+               performerClass:descriptor.performerClass];
+}
 
 @implementation MDMTargetScope {
-  id _target;
-  NSMutableDictionary<NSString *, id<MDMPerforming>> *_performerClassNameToPerformer;
-  NSMutableDictionary<NSString *, id<MDMPerforming>> *_performerPlanNameToPerformer;
+  // MDMPerformerEntry instances indexed by their MDMPerformerDescriptor slot.
+  NSPointerArray *_entries;
+  // Keyed by MDMPlanName identifier.
+  NSMapTable<id, MDMPerformerDescriptor *> *_planNameToPerformerDescriptor;
+  // Keeps the transient MDMPlanName handles of named plans alive, keyed by identifier. Allocated on
+  // first use.
+  NSMapTable<id, MDMPlanName *> *_transientPlanNames;
+  MDMPerformerDescriptorTable *_performerDescriptors;
   MDMTokenPool *_tokenPool;
-  NSOrderedSet<id<MDMTracing>> *_tracers;
+  MDMTracerTable *_tracers;
   MDMPlanEmitter *_planEmitter;
+  MDMPerformerBudget *_performerBudget;
+  MDMFrameScheduler *_frameScheduler;
+  MDMMotionSolver *_motionSolver;
+
+  // Unnamed plans can't be removed, so a scope that has received one is never idle.
+  NSUInteger _unnamedPlanCount;
+
+  // Equatable plans added while deduplication was enabled. Allocated on first use.
+  NSMutableSet<id<MDMEquatablePlan>> *_equatablePlans;
 }
 
 - (instancetype)initWithTarget:(id)target
-                       tracers:(NSOrderedSet<id<MDMTracing>> *)tracers
+                       tracers:(MDMTracerTable *)tracers
+          performerDescriptors:(MDMPerformerDescriptorTable *)performerDescriptors
                    planEmitter:(MDMPlanEmitter *)planEmitter
-                     tokenPool:(MDMTokenPool *)tokenPool {
+               performerBudget:(MDMPerformerBudget *)performerBudget
+                frameScheduler:(MDMFrameScheduler *)frameScheduler
+                  motionSolver:(MDMMotionSolver *)motionSolver {
   self = [super init];
   if (self) {
     _target = target;
     _tracers = tracers;
+    _performerDescriptors = performerDescriptors;
     _planEmitter = planEmitter;
-    _tokenPool = tokenPool;
-    _performerClassNameToPerformer = [NSMutableDictionary dictionary];
-    _performerPlanNameToPerformer = [NSMutableDictionary dictionary];
+    _performerBudget = performerBudget;
+    _frameScheduler = frameScheduler;
+    _motionSolver = motionSolver;
+    _entries = [NSPointerArray strongObjectsPointerArray];
+    _planNameToPerformerDescriptor =
+        [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsOpaqueMemory
+                                                | NSPointerFunctionsIntegerPersonality)
+                                  valueOptions:NSPointerFunctionsStrongMemory
+                                      capacity:0];
   }
   return self;
 }
 
+- (void)dealloc {
+  [self releaseAllPerformers];
+}
+
+- (BOOL)isIdle {
+  return _unnamedPlanCount == 0 && _activeTokenCount == 0
+      && NSCountMapTable(_planNameToPerformerDescriptor) == 0;
+}
+
+- (MDMTokenPool *)tokenPool {
+  // Allocated on first use since scopes whose performers aren't continuous never need tokens.
+  if (!_tokenPool) {
+    _tokenPool = [[MDMTokenPool alloc] initWithPerformerDescriptors:_performerDescriptors];
+  }
+  return _tokenPool;
+}
+
+- (NSUInteger)tokenCount {
+  return _tokenPool.tokenCount;
+}
+
+- (NSUInteger)namedPlanCount {
+  return NSCountMapTable(_planNameToPerformerDescriptor);
+}
+
+- (void)enumeratePerformersUsingBlock:(void (^)(id<MDMPerforming>))block {
+  for (NSUInteger slot = 0; slot < _entries.count; slot++) {
+    MDMPerformerEntry *entry = [self entryAtSlot:slot];
+    if (entry && entry->_performer) {
+      block(entry->_performer);
+    }
+  }
+}
+
+- (void)enumerateRetainedPlansUsingBlock:(void (^)(id<MDMPlan>))block {
+  for (NSUInteger slot = 0; slot < _entries.count; slot++) {
+    MDMPerformerEntry *entry = [self entryAtSlot:slot];
+    if (!entry) {
+      continue;
+    }
+    for (id<MDMPlan> plan in entry->_retainedPlans) {
+      block(plan);
+    }
+  }
+}
+
+- (void)retire {
+  [self releaseAllPerformers];
+
+  __autoreleasing NSPointerArray *retiredEntries = _entries;
+  (void)retiredEntries;
+  _entries = [NSPointerArray strongObjectsPointerArray];
+  NSResetMapTable(_planNameToPerformerDescriptor);
+  _transientPlanNames = nil;
+  _equatablePlans = nil;
+  // Performers of the retired scope may outlive it, so the next target starts with fresh tokens.
+  _tokenPool = nil;
+  _unnamedPlanCount = 0;
+  _activeTokenCount = 0;
+  _generation++;
+
+  _target = nil;
+  // Performers of the retired scope may still hold the emitter.
+  _planEmitter.target = nil;
+  _planEmitter = nil;
+}
+
+- (void)attachToTarget:(id)target planEmitter:(MDMPlanEmitter *)planEmitter {
+  _target = target;
+  _planEmitter = planEmitter;
+}
+
+#pragma mark - Token accounting
+
+- (void)didActivateTokenCount:(NSUInteger)count forPerformerSlot:(NSUInteger)slot {
+  _activeTokenCount += count;
+
+  MDMPerformerEntry *entry = [self entryAtSlot:slot];
+  if (entry) {
+    entry->_activeTokenCount += count;
+    [_performerBudget touchEntry:entry];
+  }
+}
+
+- (void)didDeactivateTokenCount:(NSUInteger)count forPerformerSlot:(NSUInteger)slot {
+  _activeTokenCount -= MIN(_activeTokenCount, count);
+
+  MDMPerformerEntry *entry = [self entryAtSlot:slot];
+  if (entry) {
+    entry->_activeTokenCount -= MIN(entry->_activeTokenCount, count);
+    [_performerBudget touchEntry:entry];
+    [_performerBudget evictIfNeeded];
+  }
+}
+
+#pragma mark - Eviction
+
+- (void)evictPerformerOfEntry:(MDMPerformerEntry *)entry {
+  __autoreleasing id<MDMPerforming> evictedPerformer = entry->_performer;
+  (void)evictedPerformer;
+  entry->_performer = nil;
+  [_performerBudget entryDidReleasePerformer:entry];
+}
+
+#pragma mark - Adding and removing plans
+
 - (void)addPlan:(NSObject<MDMPlan> *)plan to:(id)target {
-  BOOL isNew = NO;
-  id<MDMPerforming> performer = [self findOrCreatePerformerForPlan:plan isNew:&isNew];
+  _unnamedPlanCount++;
+
+  MDMPerformerDescriptor *descriptor =
+      [_performerDescriptors descriptorForPerformerClass:[plan performerClass]];
+  MDMPerformerEntry *entry = [self findOrCreatePerformerEntryWithDescriptor:descriptor];
+  entry->_unnamedPlanCount++;
+  if (_performerBudget.isEnabled) {
+    [self retainPlans:@[ plan ] forEntry:entry];
+  }
+
+  [self deliverPlan:plan toEntry:entry];
+
+  [_tracers didAddPlan:plan to:target];
+
+  if (_performerBudget.isEnabled) {
+    [_performerBudget touchEntry:entry];
+    [_performerBudget evictIfNeeded];
+  }
+}
+
+- (void)addPlans:(NSArray<NSObject<MDMPlan> *> *)plans to:(id)target {
+  _unnamedPlanCount += plans.count;
 
-  if (isNew) {
-    [self notifyPerformerCreation:performer target:target];
+  // Group the plans by performer slot. Slots are visited in order of first appearance and each
+  // group preserves the relative order of its plans.
+  NSMutableArray<MDMPerformerDescriptor *> *descriptors = [NSMutableArray array];
+  NSMapTable<MDMPerformerDescriptor *, NSMutableArray<NSObject<MDMPlan> *> *> *descriptorToPlans =
+      [NSMapTable strongToStrongObjectsMapTable];
+  for (NSObject<MDMPlan> *plan in plans) {
+    MDMPerformerDescriptor *descriptor =
+        [_performerDescriptors descriptorForPerformerClass:[plan performerClass]];
+    NSMutableArray<NSObject<MDMPlan> *> *group = [descriptorToPlans objectForKey:descriptor];
+    if (!group) {
+      group = [NSMutableArray array];
+      [descriptorToPlans setObject:group forKey:descriptor];
+      [descriptors addObject:descriptor];
+    }
+    [group addObject:plan];
   }
 
-  [performer addPlan:plan];
+  BOOL budgetEnabled = _performerBudget.isEnabled;
+  NSMutableArray<MDMPerformerEntry *> *entries =
+      budgetEnabled ? [NSMutableArray arrayWithCapacity:descriptors.count] : nil;
+  for (MDMPerformerDescriptor *descriptor in descriptors) {
+    NSArray<NSObject<MDMPlan> *> *group = [descriptorToPlans objectForKey:descriptor];
+    MDMPerformerEntry *entry = [self findOrCreatePerformerEntryWithDescriptor:descriptor];
+    entry->_unnamedPlanCount += group.count;
+    if (budgetEnabled) {
+      [self retainPlans:group forEntry:entry];
+      [entries addObject:entry];
+    }
+
+    [self deliverPlans:group toEntry:entry];
+  }
 
-  for (id<MDMTracing> tracer in _tracers) {
-    if ([tracer respondsToSelector:@selector(didAddPlan:to:)]) {
-      [tracer didAddPlan:plan to:target];
+  [_tracers didAddPlans:plans to:target];
+
+  if (budgetEnabled) {
+    for (MDMPerformerEntry *entry in entries) {
+      [_performerBudget touchEntry:entry];
     }
+    [_performerBudget evictIfNeeded];
   }
 }
 
-- (void)addPlan:(NSObject<MDMNamedPlan> *)plan named:(NSString *)name to:(id)target {
-  id<MDMNamedPlanPerforming> performer = (id<MDMNamedPlanPerforming>)_performerPlanNameToPerformer[name];
-  [self removePlanNamed:name from:target withPerformer:performer];
+- (void)addPlan:(NSObject<MDMNamedPlan> *)plan named:(MDMPlanName *)name to:(id)target {
+  void *key = (void *)(uintptr_t)name.identifier;
+  MDMPerformerDescriptor *previousDescriptor =
+      (__bridge MDMPerformerDescriptor *)NSMapGet(_planNameToPerformerDescriptor, key);
+  MDMPerformerDescriptor *descriptor =
+      [_performerDescriptors descriptorForPerformerClass:[plan performerClass]];
+
+  if (previousDescriptor == descriptor
+      && (descriptor.capabilities & MDMPerformerCapabilityReplace)) {
+    MDMPerformerEntry *entry = [self entryAtSlot:descriptor.slot];
+    id<MDMNamedPlanPerforming> performer = (id<MDMNamedPlanPerforming>)entry->_performer;
+    MDMPerformerLatencyRecorder *recorder = _tracers->_latencyRecorder;
+    if (!recorder) {
+      [performer replacePlanNamed:name.string withPlan:plan];
+    } else {
+      timePerformerCallback(MDMPerformerCallbackReplacePlanNamed, descriptor, recorder, ^{
+        [performer replacePlanNamed:name.string withPlan:plan];
+      });
+    }
+    [_tracers didAddPlan:plan named:name.string to:target];
 
-  BOOL isNew = NO;
-  performer = [self findOrCreatePerformerForNamedPlan:plan named:name isNew:&isNew];
-  _performerPlanNameToPerformer[name] = performer;
-  if (isNew) {
-    [self notifyPerformerCreation:performer target:target];
+    [_performerBudget touchEntry:entry];
+    [_performerBudget evictIfNeeded];
+    return;
   }
 
-  if ([performer respondsToSelector:@selector(addPlan:named:)]) {
-    [performer addPlan:plan named:name];
+  if (previousDescriptor) {
+    [self removePlanNamed:name withDescriptor:previousDescriptor from:target];
   }
-  for (id<MDMTracing> tracer in _tracers) {
-    if ([tracer respondsToSelector:@selector(didAddPlan:named:to:)]) {
-      [tracer didAddPlan:plan named:name to:target];
+
+  MDMPerformerEntry *entry = [self findOrCreatePerformerEntryWithDescriptor:descriptor];
+  NSMapInsert(_planNameToPerformerDescriptor, key, (__bridge void *)descriptor);
+  if (!name.isPermanent) {
+    if (!_transientPlanNames) {
+      _transientPlanNames =
+          [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsOpaqueMemory
+                                                  | NSPointerFunctionsIntegerPersonality)
+                                    valueOptions:NSPointerFunctionsStrongMemory
+                                        capacity:0];
+    }
+    NSMapInsert(_transientPlanNames, key, (__bridge void *)name);
+  }
+  entry->_namedPlanCount++;
+  [_performerBudget touchEntry:entry];
+
+  if (descriptor.capabilities & MDMPerformerCapabilityNamed) {
+    id<MDMNamedPlanPerforming> performer = (id<MDMNamedPlanPerforming>)entry->_performer;
+    MDMPerformerLatencyRecorder *recorder = _tracers->_latencyRecorder;
+    if (!recorder) {
+      [performer addPlan:plan named:name.string];
+    } else {
+      timePerformerCallback(MDMPerformerCallbackAddPlanNamed, descriptor, recorder, ^{
+        [performer addPlan:plan named:name.string];
+      });
     }
   }
+  [_tracers didAddPlan:plan named:name.string to:target];
+
+  [_performerBudget evictIfNeeded];
+}
+
+- (void)removePlanNamed:(MDMPlanName *)name from:(id)target {
+  MDMPerformerDescriptor *descriptor =
+      (__bridge MDMPerformerDescriptor *)NSMapGet(_planNameToPerformerDescriptor,
+                                                 (void *)(uintptr_t)name.identifier);
+  if (descriptor == nil) {
+    return;
+  }
+  [self removePlanNamed:name withDescriptor:descriptor from:target];
+  [_performerBudget evictIfNeeded];
 }
 
-- (void)removePlanNamed:(NSString *)name from:(id)target {
-  id<MDMNamedPlanPerforming> performer = (id<MDMNamedPlanPerforming>)_performerPlanNameToPerformer[name];
-  [self removePlanNamed:name from:target withPerformer:performer];
+#pragma mark - Deduplication
+
+- (BOOL)touchEquatablePlan:(id<MDMEquatablePlan>)plan {
+  if (![_equatablePlans containsObject:plan]) {
+    return NO;
+  }
+  MDMPerformerDescriptor *descriptor =
+      [_performerDescriptors descriptorForPerformerClass:[plan performerClass]];
+  MDMPerformerEntry *entry = [self entryAtSlot:descriptor.slot];
+  if (entry) {
+    [_performerBudget touchEntry:entry];
+  }
+  return YES;
+}
+
+- (void)rememberEquatablePlan:(id<MDMEquatablePlan>)plan {
+  if (!_equatablePlans) {
+    _equatablePlans = [NSMutableSet set];
+  }
+  [_equatablePlans addObject:plan];
 }
 
 #pragma mark - Private
 
-- (void)removePlanNamed:(NSString *)name from:(id)target withPerformer:(id<MDMPerforming>)performer {
-  if (performer != nil) {
-    if ([performer respondsToSelector:@selector(removePlanNamed:)]) {
-      [(id<MDMNamedPlanPerforming>)performer removePlanNamed:name];
+- (void)removePlanNamed:(MDMPlanName *)name
+         withDescriptor:(MDMPerformerDescriptor *)descriptor
+                   from:(id)target {
+  MDMPerformerEntry *entry = [self entryAtSlot:descriptor.slot];
+  if (descriptor.capabilities & MDMPerformerCapabilityNamed) {
+    id<MDMNamedPlanPerforming> performer = (id<MDMNamedPlanPerforming>)entry->_performer;
+    MDMPerformerLatencyRecorder *recorder = _tracers->_latencyRecorder;
+    if (!recorder) {
+      [performer removePlanNamed:name.string];
+    } else {
+      timePerformerCallback(MDMPerformerCallbackRemovePlanNamed, descriptor, recorder, ^{
+        [performer removePlanNamed:name.string];
+      });
     }
-    [_performerPlanNameToPerformer removeObjectForKey:name];
-    for (id<MDMTracing> tracer in _tracers) {
-      if ([tracer respondsToSelector:@selector(didRemovePlanNamed:from:)]) {
-        [tracer didRemovePlanNamed:name from:target];
-      }
+  }
+  NSMapRemove(_planNameToPerformerDescriptor, (void *)(uintptr_t)name.identifier);
+  if (entry) {
+    entry->_namedPlanCount--;
+    [_performerBudget touchEntry:entry];
+  }
+  [_tracers didRemovePlanNamed:name.string from:target];
+  if (_transientPlanNames) {
+    NSMapRemove(_transientPlanNames, (void *)(uintptr_t)name.identifier);
+  }
+}
+
+- (MDMPerformerEntry *)entryAtSlot:(NSUInteger)slot {
+  if (slot >= _entries.count) {
+    return nil;
+  }
+  return (__bridge MDMPerformerEntry *)[_entries pointerAtIndex:slot];
+}
+
+// Invoked only while the performer budget is enabled. Without a budget performers are never
+// evicted, so their plans are not needed for rehydration.
+- (void)retainPlans:(NSArray<NSObject<MDMPlan> *> *)plans forEntry:(MDMPerformerEntry *)entry {
+  if (entry->_descriptor.capabilities & MDMPerformerCapabilityRehydratable) {
+    if (!entry->_retainedPlans) {
+      entry->_retainedPlans = [NSMutableArray array];
     }
+    [entry->_retainedPlans addObjectsFromArray:plans];
   }
 }
 
-- (id<MDMNamedPlanPerforming>)findOrCreatePerformerForNamedPlan:(id<MDMNamedPlan>)plan
-                                                          named:(NSString *)name
-                                                          isNew:(BOOL *)isNew {
-  id<MDMNamedPlanPerforming> performer = (id<MDMNamedPlanPerforming>)_performerPlanNameToPerformer[name];
-  if (performer) {
-    *isNew = NO;
-    return performer;
+- (void)deliverPlan:(NSObject<MDMPlan> *)plan toEntry:(MDMPerformerEntry *)entry {
+  id<MDMPerforming> performer = entry->_performer;
+  MDMPerformerLatencyRecorder *recorder = _tracers->_latencyRecorder;
+  if (!recorder) {
+    [performer addPlan:plan];
+  } else {
+    timePerformerCallback(MDMPerformerCallbackAddPlan, entry->_descriptor, recorder, ^{
+      [performer addPlan:plan];
+    });
   }
-  performer = (id<MDMNamedPlanPerforming>)[self findOrCreatePerformerForPlan:plan isNew:isNew];
-  _performerPlanNameToPerformer[name] = performer;
-  return performer;
 }
 
-- (id<MDMPerforming>)findOrCreatePerformerForPlan:(id<MDMPlan>)plan isNew:(BOOL *)isNew {
-  Class performerClass = [plan performerClass];
-  id performerClassName = NSStringFromClass(performerClass);
-  id<MDMPerforming> performer = _performerClassNameToPerformer[performerClassName];
-  if (performer) {
-    *isNew = NO;
-    return performer;
+- (void)deliverPlans:(NSArray<NSObject<MDMPlan> *> *)plans toEntry:(MDMPerformerEntry *)entry {
+  if (!(entry->_descriptor.capabilities & MDMPerformerCapabilityBatch)) {
+    for (NSObject<MDMPlan> *plan in plans) {
+      [self deliverPlan:plan toEntry:entry];
+    }
+    return;
+  }
+  id<MDMPerforming> performer = entry->_performer;
+  MDMPerformerLatencyRecorder *recorder = _tracers->_latencyRecorder;
+  if (!recorder) {
+    [performer addPlans:plans];
+  } else {
+    timePerformerCallback(MDMPerformerCallbackAddPlans, entry->_descriptor, recorder, ^{
+      [performer addPlans:plans];
+    });
   }
-  performer = [[performerClass alloc] initWithTarget:_target];
-  _performerClassNameToPerformer[performerClassName] = performer;
-  [self setUpFeaturesForPerformer:performer];
-  *isNew = YES;
-  return performer;
 }
 
-- (void)setUpFeaturesForPerformer:(id<MDMPerforming>)performer {
+- (MDMPerformerEntry *)findOrCreatePerformerEntryWithDescriptor:
+    (MDMPerformerDescriptor *)descriptor {
+  NSUInteger slot = descriptor.slot;
+  // Slots of performers that were never created hold NULL.
+  MDMPerformerEntry *entry = [self entryAtSlot:slot];
+  if (entry && entry->_performer) {
+    return entry;
+  }
+
+  if (slot >= _entries.count) {
+    _entries.count = slot + 1;
+  }
+  BOOL rehydrating = entry != nil;
+  if (!entry) {
+    entry = [MDMPerformerEntry new];
+    entry->_descriptor = descriptor;
+    entry->_scope = self;
+    [_entries replacePointerAtIndex:slot withPointer:(__bridge void *)entry];
+  }
+
+  id target = _target;
+  __block id<MDMPerforming> performer;
+  MDMPerformerLatencyRecorder *recorder = _tracers->_latencyRecorder;
+  if (!recorder) {
+    performer = [[descriptor.performerClass alloc] initWithTarget:target];
+  } else {
+    timePerformerCallback(MDMPerformerCallbackInitWithTarget, descriptor, recorder, ^{
+      performer = [[descriptor.performerClass alloc] initWithTarget:target];
+    });
+  }
+  entry->_performer = performer;
+  [self setUpFeaturesForPerformer:performer descriptor:descriptor];
+  [self notifyPerformerCreation:performer];
+  [_performerBudget entryDidCreatePerformer:entry rehydrated:rehydrating];
+
+  if (rehydrating && entry->_retainedPlans.count > 0) {
+    [self deliverPlans:[entry->_retainedPlans copy] toEntry:entry];
+  }
+  return entry;
+}
+
+- (void)releaseAllPerformers {
+  for (NSUInteger slot = 0; slot < _entries.count; slot++) {
+    MDMPerformerEntry *entry = [self entryAtSlot:slot];
+    if (entry && entry->_performer) {
+      [self evictPerformerOfEntry:entry];
+    }
+  }
+}
+
+- (void)setUpFeaturesForPerformer:(id<MDMPerforming>)performer
+                       descriptor:(MDMPerformerDescriptor *)descriptor {
   // Composable performance
-  if ([performer respondsToSelector:@selector(setPlanEmitter:)]) {
+  if (descriptor.capabilities & MDMPerformerCapabilityComposable) {
     id<MDMComposablePerforming> composablePerformer = (id<MDMComposablePerforming>)performer;
     [composablePerformer setPlanEmitter:_planEmitter];
   }
 
   // Continuous performance
-  if ([performer respondsToSelector:@selector(givePlanTokenizer:)]) {
+  if (descriptor.capabilities & MDMPerformerCapabilityContinuous) {
     id<MDMContinuousPerforming> continuousPerformer = (id<MDMContinuousPerforming>)performer;
-    [continuousPerformer givePlanTokenizer:_tokenPool];
+    [continuousPerformer givePlanTokenizer:self.tokenPool];
   }
-}
 
-- (void)notifyPerformerCreation:(id<MDMPerforming>)performer target:(id)target {
-  for (id<MDMTracing> tracer in _tracers) {
-    if ([tracer respondsToSelector:@selector(didCreatePerformer:for:)]) {
-      [tracer didCreatePerformer:performer for:_target];
-    }
+  // Frame-scheduled performance
+  if (descriptor.capabilities & MDMPerformerCapabilityFrameScheduled) {
+    id<MDMFrameScheduledPerforming> scheduledPerformer =
+        (id<MDMFrameScheduledPerforming>)performer;
+    [scheduledPerformer setFrameScheduler:_frameScheduler];
+  }
+
+  // Solved performance
+  if (descriptor.capabilities & MDMPerformerCapabilityMotionSolver) {
+    id<MDMMotionSolverPerforming> solvedPerformer = (id<MDMMotionSolverPerforming>)performer;
+    [solvedPerformer setMotionSolver:_motionSolver];
   }
 }
 
+- (void)notifyPerformerCreation:(id<MDMPerforming>)performer {
+  id target = _target;
+  [_tracers didCreatePerformer:performer for:target];
+}
+
 @end
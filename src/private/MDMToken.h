@@ -16,14 +16,38 @@
 
 #import "MDMPerforming.h"
 
+@class MDMTargetScope;
 @protocol MDMTokenActivityObserving;
 
-@interface MDMToken : NSObject <MDMTokened>
+@interface MDMToken : NSObject <MDMTokened> {
+  // Exposed so that token groups can update many tokens without a message send per token.
+ @package
+  BOOL _active;
+  __weak id<MDMTokenActivityObserving> _observer;
+  __weak MDMTargetScope *_targetScope;
+  // The generation of _targetScope when it was assigned. Scopes are reused across targets.
+  NSUInteger _scopeGeneration;
+  // The descriptor slot of the performer that receives this token's plan.
+  NSUInteger _performerSlot;
+}
 
 - (nonnull instancetype)init NS_UNAVAILABLE;
 + (nonnull instancetype) new NS_UNAVAILABLE;
 
-- (void)addActivityObserver:(nonnull id<MDMTokenActivityObserving>)observer;
+/**
+ Associates the token with the runtime that owns it and the scope of the target it acts upon.
+
+ Both are weakly held. Only the owning runtime is informed of activity changes.
+ */
+- (void)setActivityObserver:(nonnull id<MDMTokenActivityObserving>)observer
+                targetScope:(nullable MDMTargetScope *)targetScope;
+
+/**
+ The scope of the target whose plan this token represents.
+
+ nil if the scope has since been retired.
+ */
+@property(nonatomic, weak, nullable, readonly) MDMTargetScope *targetScope;
 
 @end
 
@@ -32,4 +56,20 @@
 - (void)tokenDidActivate:(nonnull MDMToken *)token;
 - (void)tokenDidDeactivate:(nonnull MDMToken *)token;
 
+/**
+ Informs the observer that count tokens belonging to the given scope and performer slot were
+ activated at once.
+ */
+- (void)tokenCount:(NSUInteger)count
+    didActivateInTargetScope:(nullable MDMTargetScope *)scope
+               performerSlot:(NSUInteger)slot;
+
+/**
+ Informs the observer that count tokens belonging to the given scope and performer slot were
+ deactivated at once.
+ */
+- (void)tokenCount:(NSUInteger)count
+    didDeactivateInTargetScope:(nullable MDMTargetScope *)scope
+                 performerSlot:(NSUInteger)slot;
+
 @end
@@ -18,10 +18,9 @@
 #import "MDMToken+Private.h"
 
 #import "MDMPlan.h"
+#import "MDMTargetScope.h"
 
-@implementation MDMToken {
-  NSHashTable<id<MDMTokenActivityObserving>> *_observers;
-}
+@implementation MDMToken
 
 @synthesize active = _active;
 
@@ -30,11 +29,7 @@
 }
 
 - (instancetype)initInternal {
-  self = [super init];
-  if (self) {
-    _observers = [NSHashTable weakObjectsHashTable];
-  }
-  return self;
+  return [super init];
 }
 
 - (void)setActive:(BOOL)active {
@@ -45,18 +40,22 @@
   _active = active;
 
   if (_active) {
-    for (id<MDMTokenActivityObserving> observer in _observers) {
-      [observer tokenDidActivate:self];
-    }
+    [_observer tokenDidActivate:self];
   } else {
-    for (id<MDMTokenActivityObserving> observer in _observers) {
-      [observer tokenDidDeactivate:self];
-    }
+    [_observer tokenDidDeactivate:self];
   }
 }
 
-- (void)addActivityObserver:(nonnull id<MDMTokenActivityObserving>)observer {
-  [_observers addObject:observer];
+- (void)setActivityObserver:(id<MDMTokenActivityObserving>)observer
+                targetScope:(MDMTargetScope *)targetScope {
+  _observer = observer;
+  _targetScope = targetScope;
+  _scopeGeneration = targetScope.generation;
+}
+
+- (MDMTargetScope *)targetScope {
+  MDMTargetScope *scope = _targetScope;
+  return scope.generation == _scopeGeneration ? scope : nil;
 }
 
 @end
@@ -0,0 +1,38 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "MDMPerforming.h"
+
+@class MDMToken;
+
+/**
+ A token group stores its tokens in one contiguous array and batches its activity notifications.
+
+ Each run of consecutive changed tokens that share an observer, target scope and performer slot is
+ reported to its observer with a single notification. Tokens are not reordered, so an observer whose
+ tokens are interleaved with those of another observer, scope or slot is notified once per run.
+ */
+@interface MDMTokenGroup : NSObject <MDMTokenGroup>
+
+- (nonnull instancetype)initWithTokens:(nonnull NSArray<MDMToken *> *)tokens
+    NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+@end
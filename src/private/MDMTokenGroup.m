@@ -0,0 +1,128 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMTokenGroup.h"
+
+#import "MDMTargetScope.h"
+#import "MDMToken.h"
+
+@implementation MDMTokenGroup {
+  __strong MDMToken **_tokens;
+  NSUInteger _count;
+}
+
+@synthesize count = _count;
+
+- (instancetype)initWithTokens:(NSArray<MDMToken *> *)tokens {
+  self = [super init];
+  if (self) {
+    _count = tokens.count;
+    _tokens = (__strong MDMToken **)calloc(MAX(_count, 1U), sizeof(MDMToken *));
+    NSUInteger index = 0;
+    for (MDMToken *token in tokens) {
+      _tokens[index++] = token;
+    }
+  }
+  return self;
+}
+
+- (void)dealloc {
+  for (NSUInteger index = 0; index < _count; ++index) {
+    _tokens[index] = nil;
+  }
+  free(_tokens);
+}
+
+- (BOOL)isActive {
+  for (NSUInteger index = 0; index < _count; ++index) {
+    if (_tokens[index]->_active) {
+      return YES;
+    }
+  }
+  return NO;
+}
+
+- (void)setActive:(BOOL)active {
+  // A notification may release the group, its observer or its scope, so all three are held
+  // strongly until every run has been reported.
+  __attribute__((objc_precise_lifetime)) MDMTokenGroup *retainedSelf = self;
+  (void)retainedSelf;
+
+  // The run of consecutive changed tokens that share an observer, scope and performer slot.
+  id<MDMTokenActivityObserving> runObserver = nil;
+  MDMTargetScope *runScope = nil;
+  NSUInteger runScopeGeneration = 0;
+  NSUInteger runPerformerSlot = 0;
+  NSUInteger runCount = 0;
+
+  for (NSUInteger index = 0; index < _count; ++index) {
+    MDMToken *token = _tokens[index];
+    if (token->_active == active) {
+      continue;
+    }
+    token->_active = active;
+
+    id<MDMTokenActivityObserving> observer = token->_observer;
+    MDMTargetScope *scope = token->_targetScope;
+    if (observer != runObserver || scope != runScope
+        || token->_scopeGeneration != runScopeGeneration
+        || token->_performerSlot != runPerformerSlot) {
+      [self notifyObserver:runObserver
+                     count:runCount
+                     scope:runScope
+           scopeGeneration:runScopeGeneration
+             performerSlot:runPerformerSlot
+                    active:active];
+      runObserver = observer;
+      runScope = scope;
+      runScopeGeneration = token->_scopeGeneration;
+      runPerformerSlot = token->_performerSlot;
+      runCount = 0;
+    }
+    runCount++;
+  }
+
+  [self notifyObserver:runObserver
+                 count:runCount
+                 scope:runScope
+       scopeGeneration:runScopeGeneration
+         performerSlot:runPerformerSlot
+                active:active];
+}
+
+#pragma mark - Private
+
+- (void)notifyObserver:(id<MDMTokenActivityObserving>)observer
+                 count:(NSUInteger)count
+                 scope:(MDMTargetScope *)scope
+       scopeGeneration:(NSUInteger)scopeGeneration
+         performerSlot:(NSUInteger)performerSlot
+                active:(BOOL)active {
+  if (!observer || count == 0) {
+    return;
+  }
+  // Tokens whose scope has been retired no longer count towards any target.
+  if (scope.generation != scopeGeneration) {
+    scope = nil;
+  }
+  if (active) {
+    [observer tokenCount:count didActivateInTargetScope:scope performerSlot:performerSlot];
+  } else {
+    [observer tokenCount:count didDeactivateInTargetScope:scope performerSlot:performerSlot];
+  }
+}
+
+@end
@@ -16,5 +16,18 @@
 
 #import "MDMPerforming.h"
 
+@class MDMPerformerDescriptorTable;
+
+/** Generates the tokens for the plans of a single target scope. */
 @interface MDMTokenPool : NSObject <MDMPlanTokenizing>
+
+- (nonnull instancetype)initWithPerformerDescriptors:(nonnull MDMPerformerDescriptorTable *)performerDescriptors
+    NS_DESIGNATED_INITIALIZER;
+
+- (nonnull instancetype)init NS_UNAVAILABLE;
++ (nonnull instancetype) new NS_UNAVAILABLE;
+
+/** The number of tokens whose plans are still alive. */
+@property(nonatomic, assign, readonly) NSUInteger tokenCount;
+
 @end
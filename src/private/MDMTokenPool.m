@@ -16,32 +16,68 @@
 
 #import "MDMTokenPool.h"
 
+#import "MDMPerformerDescriptor.h"
 #import "MDMPlan.h"
 #import "MDMToken+Private.h"
+#import "MDMTokenGroup.h"
 
 @implementation MDMTokenPool {
   NSMapTable<id<MDMPlan>, id<MDMTokened>> *_planToToken;
+  MDMPerformerDescriptorTable *_performerDescriptors;
 }
 
-- (instancetype)init {
+- (instancetype)initWithPerformerDescriptors:(MDMPerformerDescriptorTable *)performerDescriptors {
   self = [super init];
   if (self) {
-    _planToToken = [NSMapTable weakToStrongObjectsMapTable];
+    _performerDescriptors = performerDescriptors;
+    // Plans are keyed by identity. Equatable and replayable plans implement value equality, and
+    // equal plan instances must not share a token.
+    _planToToken =
+        [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsWeakMemory
+                                                | NSPointerFunctionsObjectPointerPersonality)
+                                  valueOptions:NSPointerFunctionsStrongMemory
+                                      capacity:0];
   }
   return self;
 }
 
+- (NSUInteger)tokenCount {
+  // The map table may retain entries for deallocated plans until its next mutation, so only count
+  // the keys that are still alive.
+  NSUInteger count = 0;
+  for (id plan in _planToToken) {
+    if (plan) {
+      count++;
+    }
+  }
+  return count;
+}
+
 - (id<MDMTokened>)tokenForPlan:(id<MDMPlan>)plan {
   // Performers that can't be continuous can never generate tokens.
-  if (![[plan performerClass] instancesRespondToSelector:@selector(givePlanTokenizer:)]) {
+  MDMPerformerDescriptor *descriptor =
+      [_performerDescriptors descriptorForPerformerClass:[plan performerClass]];
+  if (!(descriptor.capabilities & MDMPerformerCapabilityContinuous)) {
     return nil;
   }
   id<MDMTokened> token = [_planToToken objectForKey:plan];
   if (!token) {
     token = [[MDMToken alloc] initInternal];
+    token->_performerSlot = descriptor.slot;
     [_planToToken setObject:token forKey:plan];
   }
   return token;
 }
 
+- (id<MDMTokenGroup>)tokenGroupForPlans:(NSArray<id<MDMPlan>> *)plans {
+  NSMutableArray<MDMToken *> *tokens = [NSMutableArray arrayWithCapacity:plans.count];
+  for (id<MDMPlan> plan in plans) {
+    MDMToken *token = (MDMToken *)[self tokenForPlan:plan];
+    if (token) {
+      [tokens addObject:token];
+    }
+  }
+  return [[MDMTokenGroup alloc] initWithTokens:tokens];
+}
+
 @end
@@ -0,0 +1,81 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMTracing.h"
+
+@class MDMPerformerLatencyRecorder;
+
+/**
+ A plan observer is informed whenever plans are added to or removed from a target.
+
+ Unlike MDMTracing events, these notifications are always delivered synchronously on the thread
+ that changed the plans, even while asynchronous delivery is enabled, and are never dropped.
+ */
+@protocol MDMTargetPlanObserving <NSObject>
+
+- (void)plansDidChangeForTarget:(nonnull id)target;
+
+@end
+
+/**
+ Holds a runtime's tracers along with one precomputed list of implementing tracers per MDMTracing
+ event.
+
+ The per-event lists are rebuilt only when a tracer is added or removed. Dispatching an event that
+ no tracer implements costs a single branch.
+ */
+@interface MDMTracerTable : NSObject <MDMTracing> {
+ @package
+  // Read directly by target scopes so that untimed performer callbacks cost a single branch.
+  MDMPerformerLatencyRecorder *_latencyRecorder;
+}
+
+/** Registers a tracer. Does nothing if the tracer is already registered. */
+- (void)addTracer:(nonnull id<MDMTracing>)tracer;
+
+/** Unregisters a tracer. Does nothing if the tracer is not registered. */
+- (void)removeTracer:(nonnull id<MDMTracing>)tracer;
+
+/** The registered tracers, in registration order. */
+@property(nonatomic, copy, nonnull, readonly) NSArray<id<MDMTracing>> *tracers;
+
+/** Registers a plan observer. Does nothing if the observer is already registered. */
+- (void)addPlanObserver:(nonnull id<MDMTargetPlanObserving>)observer;
+
+/** Unregisters a plan observer. Does nothing if the observer is not registered. */
+- (void)removePlanObserver:(nonnull id<MDMTargetPlanObserving>)observer;
+
+/** Times every performer callback of the runtime's target scopes when non-nil. */
+@property(nonatomic, strong, nullable) MDMPerformerLatencyRecorder *latencyRecorder;
+
+#pragma mark Asynchronous delivery
+
+/**
+ Whether events are delivered to tracers on a background thread.
+
+ When enabled, events are written to a fixed-size ring buffer and the tracers are invoked from a
+ background thread in the order in which the events occurred. Disabling delivers any outstanding
+ events before returning.
+ */
+@property(nonatomic, assign, getter=isAsynchronous) BOOL asynchronous;
+
+/** The number of events dropped because the asynchronous ring buffer was full. */
+@property(nonatomic, assign, readonly) NSUInteger droppedEventCount;
+
+/** Blocks until all asynchronously dispatched events have been delivered. */
+- (void)flush;
+
+@end
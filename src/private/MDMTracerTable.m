@@ -0,0 +1,314 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#import "MDMTracerTable.h"
+
+#import "MDMAsyncTracerPipeline.h"
+
+// The number of events that may be awaiting asynchronous delivery at any given time.
+static const NSUInteger kAsyncTracerPipelineCapacity = 4096;
+
+@interface MDMTracerTable () <MDMTraceRecordDelivering>
+@end
+
+@implementation MDMTracerTable {
+  NSMutableOrderedSet<id<MDMTracing>> *_tracers;
+
+  // Each list is nil when no registered tracer implements the event.
+  NSArray<id<MDMTracing>> *_didAddPlanTracers;
+  NSArray<id<MDMTracing>> *_didAddPlansTracers;
+  NSArray<id<MDMTracing>> *_didAddPlanTracersWithoutBatchSupport;
+  NSArray<id<MDMTracing>> *_didAddPlanNamedTracers;
+  NSArray<id<MDMTracing>> *_didRemovePlanNamedTracers;
+  NSArray<id<MDMTracing>> *_didCreatePerformerTracers;
+  NSArray<id<MDMTracing>> *_didDropEmittedPlanTracers;
+
+  // nil if there are no plan observers.
+  NSArray<id<MDMTargetPlanObserving>> *_planObservers;
+
+  // Non-nil while asynchronous delivery is enabled.
+  MDMAsyncTracerPipeline *_pipeline;
+  NSUInteger _droppedEventCountOfStoppedPipelines;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _tracers = [NSMutableOrderedSet orderedSet];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [_pipeline stop];
+}
+
+#pragma mark - Public
+
+- (void)addTracer:(id<MDMTracing>)tracer {
+  if ([_tracers containsObject:tracer]) {
+    return;
+  }
+  [_tracers addObject:tracer];
+  [self rebuildDispatchLists];
+}
+
+- (void)removeTracer:(id<MDMTracing>)tracer {
+  if (![_tracers containsObject:tracer]) {
+    return;
+  }
+  [_tracers removeObject:tracer];
+  [self rebuildDispatchLists];
+}
+
+- (NSArray<id<MDMTracing>> *)tracers {
+  return _tracers.array;
+}
+
+- (void)addPlanObserver:(id<MDMTargetPlanObserving>)observer {
+  if ([_planObservers containsObject:observer]) {
+    return;
+  }
+  _planObservers = _planObservers ? [_planObservers arrayByAddingObject:observer] : @[ observer ];
+}
+
+- (void)removePlanObserver:(id<MDMTargetPlanObserving>)observer {
+  if (![_planObservers containsObject:observer]) {
+    return;
+  }
+  NSMutableArray<id<MDMTargetPlanObserving>> *observers = [_planObservers mutableCopy];
+  [observers removeObject:observer];
+  _planObservers = observers.count > 0 ? [observers copy] : nil;
+}
+
+- (BOOL)isAsynchronous {
+  return _pipeline != nil;
+}
+
+- (void)setAsynchronous:(BOOL)asynchronous {
+  if (asynchronous == (_pipeline != nil)) {
+    return;
+  }
+  if (asynchronous) {
+    _pipeline = [[MDMAsyncTracerPipeline alloc] initWithCapacity:kAsyncTracerPipelineCapacity
+                                                       deliverer:self];
+  } else {
+    [_pipeline stop];
+    _droppedEventCountOfStoppedPipelines += _pipeline.droppedEventCount;
+    _pipeline = nil;
+  }
+}
+
+- (NSUInteger)droppedEventCount {
+  return _droppedEventCountOfStoppedPipelines + _pipeline.droppedEventCount;
+}
+
+- (void)flush {
+  [_pipeline flush];
+}
+
+#pragma mark - Private
+
+static NSArray<id<MDMTracing>> *tracersRespondingToSelector(NSOrderedSet<id<MDMTracing>> *tracers,
+                                                            SEL selector,
+                                                            SEL excludedSelector) {
+  NSMutableArray<id<MDMTracing>> *responders = [NSMutableArray array];
+  for (id<MDMTracing> tracer in tracers) {
+    if ([tracer respondsToSelector:selector]
+        && !(excludedSelector && [tracer respondsToSelector:excludedSelector])) {
+      [responders addObject:tracer];
+    }
+  }
+  return responders.count > 0 ? [responders copy] : nil;
+}
+
+- (void)rebuildDispatchLists {
+  // The background thread reads the dispatch lists, so it must be idle while they change.
+  [_pipeline flush];
+
+  _didAddPlanTracers = tracersRespondingToSelector(_tracers, @selector(didAddPlan:to:), NULL);
+  _didAddPlansTracers = tracersRespondingToSelector(_tracers, @selector(didAddPlans:to:), NULL);
+  _didAddPlanTracersWithoutBatchSupport =
+      tracersRespondingToSelector(_tracers, @selector(didAddPlan:to:), @selector(didAddPlans:to:));
+  _didAddPlanNamedTracers =
+      tracersRespondingToSelector(_tracers, @selector(didAddPlan:named:to:), NULL);
+  _didRemovePlanNamedTracers =
+      tracersRespondingToSelector(_tracers, @selector(didRemovePlanNamed:from:), NULL);
+  _didCreatePerformerTracers =
+      tracersRespondingToSelector(_tracers, @selector(didCreatePerformer:for:), NULL);
+  _didDropEmittedPlanTracers =
+      tracersRespondingToSelector(_tracers, @selector(didDropEmittedPlan:to:), NULL);
+}
+
+- (void)notifyPlanObserversForTarget:(id)target {
+  for (id<MDMTargetPlanObserving> observer in _planObservers) {
+    [observer plansDidChangeForTarget:target];
+  }
+}
+
+- (void)deliverDidAddPlan:(id<MDMPlan>)plan to:(id)target {
+  for (id<MDMTracing> tracer in _didAddPlanTracers) {
+    [tracer didAddPlan:plan to:target];
+  }
+}
+
+- (void)deliverDidAddPlans:(NSArray<id<MDMPlan>> *)plans to:(id)target {
+  for (id<MDMTracing> tracer in _didAddPlansTracers) {
+    [tracer didAddPlans:plans to:target];
+  }
+  for (id<MDMTracing> tracer in _didAddPlanTracersWithoutBatchSupport) {
+    for (id<MDMPlan> plan in plans) {
+      [tracer didAddPlan:plan to:target];
+    }
+  }
+}
+
+- (void)deliverDidAddPlan:(id<MDMNamedPlan>)plan named:(NSString *)name to:(id)target {
+  for (id<MDMTracing> tracer in _didAddPlanNamedTracers) {
+    [tracer didAddPlan:plan named:name to:target];
+  }
+}
+
+- (void)deliverDidRemovePlanNamed:(NSString *)name from:(id)target {
+  for (id<MDMTracing> tracer in _didRemovePlanNamedTracers) {
+    [tracer didRemovePlanNamed:name from:target];
+  }
+}
+
+- (void)deliverDidCreatePerformer:(id<MDMPerforming>)performer for:(id)target {
+  for (id<MDMTracing> tracer in _didCreatePerformerTracers) {
+    [tracer didCreatePerformer:performer for:target];
+  }
+}
+
+- (void)deliverDidDropEmittedPlan:(id<MDMPlan>)plan to:(id)target {
+  for (id<MDMTracing> tracer in _didDropEmittedPlanTracers) {
+    [tracer didDropEmittedPlan:plan to:target];
+  }
+}
+
+#pragma mark - MDMTraceRecordDelivering
+
+- (void)deliverTraceRecord:(const MDMTraceRecord *)record {
+  id object = (__bridge id)record->object;
+  id target = (__bridge id)record->target;
+  NSString *name = (__bridge NSString *)record->name;
+  switch (record->type) {
+    case MDMTraceEventTypeDidAddPlan:
+      [self deliverDidAddPlan:object to:target];
+      break;
+    case MDMTraceEventTypeDidAddPlans:
+      [self deliverDidAddPlans:object to:target];
+      break;
+    case MDMTraceEventTypeDidAddPlanNamed:
+      [self deliverDidAddPlan:object named:name to:target];
+      break;
+    case MDMTraceEventTypeDidRemovePlanNamed:
+      [self deliverDidRemovePlanNamed:name from:target];
+      break;
+    case MDMTraceEventTypeDidCreatePerformer:
+      [self deliverDidCreatePerformer:object for:target];
+      break;
+    case MDMTraceEventTypeDidDropEmittedPlan:
+      [self deliverDidDropEmittedPlan:object to:target];
+      break;
+  }
+}
+
+#pragma mark - MDMTracing
+
+- (void)didAddPlan:(id<MDMPlan>)plan to:(id)target {
+  if (_planObservers) {
+    [self notifyPlanObserversForTarget:target];
+  }
+  if (!_didAddPlanTracers) {
+    return;
+  }
+  if (_pipeline) {
+    [_pipeline enqueueEventOfType:MDMTraceEventTypeDidAddPlan object:plan target:target name:nil];
+  } else {
+    [self deliverDidAddPlan:plan to:target];
+  }
+}
+
+- (void)didAddPlans:(NSArray<id<MDMPlan>> *)plans to:(id)target {
+  if (_planObservers) {
+    [self notifyPlanObserversForTarget:target];
+  }
+  if (!_didAddPlansTracers && !_didAddPlanTracersWithoutBatchSupport) {
+    return;
+  }
+  if (_pipeline) {
+    [_pipeline enqueueEventOfType:MDMTraceEventTypeDidAddPlans object:plans target:target name:nil];
+  } else {
+    [self deliverDidAddPlans:plans to:target];
+  }
+}
+
+- (void)didAddPlan:(id<MDMNamedPlan>)plan named:(NSString *)name to:(id)target {
+  if (_planObservers) {
+    [self notifyPlanObserversForTarget:target];
+  }
+  if (!_didAddPlanNamedTracers) {
+    return;
+  }
+  if (_pipeline) {
+    [_pipeline enqueueEventOfType:MDMTraceEventTypeDidAddPlanNamed object:plan target:target name:name];
+  } else {
+    [self deliverDidAddPlan:plan named:name to:target];
+  }
+}
+
+- (void)didRemovePlanNamed:(NSString *)name from:(id)target {
+  if (_planObservers) {
+    [self notifyPlanObserversForTarget:target];
+  }
+  if (!_didRemovePlanNamedTracers) {
+    return;
+  }
+  if (_pipeline) {
+    [_pipeline enqueueEventOfType:MDMTraceEventTypeDidRemovePlanNamed object:nil target:target name:name];
+  } else {
+    [self deliverDidRemovePlanNamed:name from:target];
+  }
+}
+
+- (void)didCreatePerformer:(id<MDMPerforming>)performer for:(id)target {
+  if (!_didCreatePerformerTracers) {
+    return;
+  }
+  if (_pipeline) {
+    [_pipeline enqueueEventOfType:MDMTraceEventTypeDidCreatePerformer object:performer target:target name:nil];
+  } else {
+    [self deliverDidCreatePerformer:performer for:target];
+  }
+}
+
+- (void)didDropEmittedPlan:(id<MDMPlan>)plan to:(id)target {
+  if (!_didDropEmittedPlanTracers) {
+    return;
+  }
+  if (_pipeline) {
+    [_pipeline enqueueEventOfType:MDMTraceEventTypeDidDropEmittedPlan
+                           object:plan
+                           target:target
+                             name:nil];
+  } else {
+    [self deliverDidDropEmittedPlan:plan to:target];
+  }
+}
+
+@end
@@ -0,0 +1,115 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import Foundation
+import MaterialMotionRuntime
+
+/** A target that records the values appended by AppendValue and NamedValue plans. */
+public class ValuesTarget: NSObject {
+  public var values: [Int] = []
+}
+
+/**
+ An equatable plan that appends its value to a ValuesTarget.
+
+ The performer tokenizes each plan without activating it and keeps the plan alive so that its token
+ remains in the pool.
+ */
+public class AppendValue: NSObject, EquatablePlan {
+  public let value: Int
+
+  public init(value: Int) {
+    self.value = value
+  }
+
+  public override func isEqual(_ object: Any?) -> Bool {
+    return (object as? AppendValue)?.value == value
+  }
+
+  public override var hash: Int {
+    return value
+  }
+
+  public func performerClass() -> AnyClass {
+    return Performer.self
+  }
+
+  public func copy(with zone: NSZone? = nil) -> Any {
+    return AppendValue(value: value)
+  }
+
+  private class Performer: NSObject, ContinuousPerforming {
+    // Weak so that targets can be deallocated while the runtime holds their performers.
+    weak var target: ValuesTarget?
+    required init(target: Any) {
+      self.target = target as? ValuesTarget
+    }
+
+    var plans: [Plan] = []
+
+    func addPlan(_ plan: Plan) {
+      target?.values.append((plan as! AppendValue).value)
+      plans.append(plan)
+      _ = planTokenizer.token(for: plan)
+    }
+
+    func addPlans(_ plans: [Plan]) {
+      for plan in plans {
+        addPlan(plan)
+      }
+    }
+
+    var planTokenizer: PlanTokenizing!
+    func givePlanTokenizer(_ planTokenizer: PlanTokenizing) {
+      self.planTokenizer = planTokenizer
+    }
+  }
+}
+
+/** A named plan that appends its value to a ValuesTarget, and -1 when it is removed. */
+public class NamedValue: NSObject, NamedPlan {
+  public let value: Int
+
+  public init(value: Int) {
+    self.value = value
+  }
+
+  public func performerClass() -> AnyClass {
+    return Performer.self
+  }
+
+  public func copy(with zone: NSZone? = nil) -> Any {
+    return NamedValue(value: value)
+  }
+
+  private class Performer: NSObject, NamedPlanPerforming {
+    weak var target: ValuesTarget?
+    required init(target: Any) {
+      self.target = target as? ValuesTarget
+    }
+
+    func addPlan(_ plan: Plan) {
+    }
+
+    func addPlan(_ plan: NamedPlan, named name: String) {
+      target?.values.append((plan as! NamedValue).value)
+    }
+
+    func removePlan(named name: String) {
+      target?.values.append(-1)
+    }
+  }
+}
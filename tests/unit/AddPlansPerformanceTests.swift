@@ -0,0 +1,93 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+// Measures the per-plan cost of addPlans:to: at different batch sizes.
+//
+// Every measurement adds the same total number of plans to a performer and a tracer that both
+// receive the batched callbacks, so the reported time divided by totalPlans is the per-plan cost
+// for the given batch size. Only the addPlans:to: calls are measured. The addPlansBatched cases of
+// the benchmarks tool report the per-plan cost directly.
+class AddPlansPerformanceTests: XCTestCase {
+
+  let totalPlans = 1000
+
+  func testPerPlanCostWithBatchSizeOf1() {
+    measureAddPlans(batchSize: 1)
+  }
+
+  func testPerPlanCostWithBatchSizeOf10() {
+    measureAddPlans(batchSize: 10)
+  }
+
+  func testPerPlanCostWithBatchSizeOf100() {
+    measureAddPlans(batchSize: 100)
+  }
+
+  func testPerPlanCostWithBatchSizeOf1000() {
+    measureAddPlans(batchSize: 1000)
+  }
+
+  private func measureAddPlans(batchSize: Int) {
+    let plans: [Plan] = (0..<batchSize).map { _ in NoOp() }
+    let numberOfBatches = totalPlans / batchSize
+
+    measureMetrics(type(of: self).defaultPerformanceMetrics(), automaticallyStartMeasuring: false) {
+      // A fresh runtime per iteration keeps earlier iterations' plans out of the measurement.
+      let runtime = MotionRuntime()
+      runtime.addTracer(NoOpTracer())
+      let target = NSObject()
+
+      startMeasuring()
+      for _ in 0..<numberOfBatches {
+        runtime.addPlans(plans, to: target)
+      }
+      stopMeasuring()
+    }
+  }
+
+  private class NoOpTracer: NSObject, Tracing {
+    func didAddPlan(_ plan: Plan, to target: Any) {
+    }
+
+    func didAddPlans(_ plans: [Plan], to target: Any) {
+    }
+  }
+
+  private class NoOp: NSObject, Plan {
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return NoOp()
+    }
+
+    private class Performer: NSObject, Performing {
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+      }
+
+      func addPlans(_ plans: [Plan]) {
+      }
+    }
+  }
+}
@@ -0,0 +1,67 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+class BinaryTraceRecorderTests: XCTestCase {
+
+  var path: String!
+
+  override func setUp() {
+    super.setUp()
+    path = (NSTemporaryDirectory() as NSString).appendingPathComponent("\(UUID().uuidString).mdmtrace")
+  }
+
+  override func tearDown() {
+    try? FileManager.default.removeItem(atPath: path)
+    path = nil
+    super.tearDown()
+  }
+
+  func testRecordsOneRecordPerEvent() {
+    let recorder = try! BinaryTraceRecorder(path: path, recordCapacity: 16)
+    let runtime = MotionRuntime()
+    runtime.addTracer(recorder)
+
+    let target = NSObject()
+    runtime.addPlans([InstantlyInactive(), InstantlyInactive()], to: target)
+
+    // One didCreatePerformer and two didAddPlan records.
+    XCTAssertEqual(recorder.recordCount, 3)
+  }
+
+  func testCaptureFileIsPreallocated() {
+    let recorder = try! BinaryTraceRecorder(path: path, recordCapacity: 1024)
+    recorder.close()
+
+    let attributes = try! FileManager.default.attributesOfItem(atPath: path)
+    let size = (attributes[.size] as! NSNumber).intValue
+    XCTAssertGreaterThan(size, 1024 * 32)
+  }
+
+  func testEventsAfterCloseAreIgnored() {
+    let recorder = try! BinaryTraceRecorder(path: path, recordCapacity: 16)
+    recorder.close()
+
+    let runtime = MotionRuntime()
+    runtime.addTracer(recorder)
+    runtime.addPlan(InstantlyInactive(), to: NSObject())
+
+    XCTAssertEqual(recorder.recordCount, 0)
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+class ClockTests: XCTestCase {
+
+  func testVirtualClockAdvancesInSteps() {
+    let clock = VirtualClock()
+    let observer = TickRecorder()
+    clock.addClockObserver(observer)
+
+    clock.advance(by: 1, inStepsOf: 1.0 / 60.0)
+
+    XCTAssertEqual(observer.tickTimes.count, 60)
+    XCTAssertEqualWithAccuracy(observer.tickTimes[0], 1.0 / 60.0, accuracy: 1e-12)
+    XCTAssertEqual(observer.tickTimes.last, 1)
+    XCTAssertEqual(clock.currentTime, 1)
+  }
+
+  func testVirtualClockShortensTheLastStep() {
+    let clock = VirtualClock()
+    let observer = TickRecorder()
+    clock.addClockObserver(observer)
+
+    clock.advance(by: 0.5, inStepsOf: 0.2)
+
+    XCTAssertEqual(observer.tickTimes.count, 3)
+    XCTAssertEqual(observer.tickTimes.last, 0.5)
+  }
+
+  func testMonotonicClockNeverDecreases() {
+    let clock = MonotonicClock()
+    let first = clock.currentTime
+    let second = clock.currentTime
+    XCTAssertGreaterThanOrEqual(second, first)
+  }
+
+  func testMonotonicClockTicksOnDemand() {
+    let clock = MonotonicClock()
+    let observer = TickRecorder()
+    clock.addClockObserver(observer)
+
+    clock.tick()
+    clock.removeClockObserver(observer)
+    clock.tick()
+
+    XCTAssertEqual(observer.tickTimes.count, 1)
+  }
+}
+
+private class TickRecorder: NSObject, ClockObserving {
+  var tickTimes: [TimeInterval] = []
+
+  func clockDidTick(_ clock: Clock) {
+    tickTimes.append(clock.currentTime)
+  }
+}
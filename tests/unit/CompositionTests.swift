@@ -39,4 +39,388 @@ class CompositionTests: XCTestCase {
     XCTAssertTrue(delegate.activityStateDidChange)
     XCTAssertFalse(runtime.isActive)
   }
+
+  func testEmittedPlansAreAddedAfterTheEmittingPerformerReturns() {
+    let runtime = MotionRuntime()
+    let target = LogTarget()
+
+    runtime.addPlan(EmitThenLog(plan: Log(entry: "child"), entry: "parent"), to: target)
+
+    XCTAssertEqual(target.log, ["parent", "child"])
+  }
+
+  func testEmittedPlansForTheSameTargetAreBatched() {
+    let runtime = MotionRuntime()
+    let target = LogTarget()
+
+    let children = [Log(entry: "a"), Log(entry: "b"), Log(entry: "c")]
+    runtime.addPlan(EmitAll(plans: children), to: target)
+
+    XCTAssertEqual(target.log, ["batch a b c"])
+  }
+
+  func testEmissionCyclesAreCutOffAtTheMaximumDepth() {
+    let runtime = MotionRuntime()
+    runtime.maximumPlanEmissionDepth = 5
+    let tracer = DropTracer()
+    runtime.addTracer(tracer)
+    let target = LogTarget()
+
+    runtime.addPlan(EmitForever(), to: target)
+
+    XCTAssertEqual(target.log.count, 6)
+    XCTAssertEqual(runtime.droppedEmittedPlanCount, 1)
+    XCTAssertEqual(tracer.droppedPlanCount, 1)
+  }
+
+  func testEmittedPlansBeyondTheMaximumCountAreDropped() {
+    let runtime = MotionRuntime()
+    runtime.maximumEmittedPlanCount = 2
+    let target = LogTarget()
+
+    let children = [Log(entry: "a"), Log(entry: "b"), Log(entry: "c")]
+    runtime.addPlan(EmitAll(plans: children), to: target)
+
+    XCTAssertEqual(target.log, ["batch a b"])
+    XCTAssertEqual(runtime.droppedEmittedPlanCount, 1)
+  }
+
+  func testReplayablePlansReplayTheirRecordedTemplate() {
+    let runtime = MotionRuntime()
+    Expand.expansionCount = 0
+    let first = LogTarget()
+    let second = LogTarget()
+
+    runtime.addPlan(Expand(prefix: "x"), to: first)
+    runtime.addPlan(Expand(prefix: "x"), to: second)
+
+    XCTAssertEqual(first.log, ["batch x1 x2"])
+    XCTAssertEqual(second.log, ["batch x1 x2"])
+    XCTAssertEqual(Expand.expansionCount, 1)
+    XCTAssertEqual(runtime.replayedPlanTemplateCount, 1)
+  }
+
+  func testReplayablePlansWithDifferentConfigurationsAreExpandedSeparately() {
+    let runtime = MotionRuntime()
+    Expand.expansionCount = 0
+    let target = LogTarget()
+
+    runtime.addPlan(Expand(prefix: "x"), to: target)
+    runtime.addPlan(Expand(prefix: "y"), to: target)
+
+    XCTAssertEqual(target.log, ["batch x1 x2", "batch y1 y2"])
+    XCTAssertEqual(Expand.expansionCount, 2)
+    XCTAssertEqual(runtime.replayedPlanTemplateCount, 0)
+  }
+
+  func testInvalidatedTemplatesAreRecordedAgain() {
+    let runtime = MotionRuntime()
+    Expand.expansionCount = 0
+
+    runtime.addPlan(Expand(prefix: "x"), to: LogTarget())
+    runtime.invalidatePlanTemplates(for: Expand.self)
+    runtime.addPlan(Expand(prefix: "x"), to: LogTarget())
+
+    XCTAssertEqual(Expand.expansionCount, 2)
+    XCTAssertEqual(runtime.replayedPlanTemplateCount, 0)
+  }
+
+  func testMixedBatchesAreDeliveredInOrder() {
+    let runtime = MotionRuntime()
+    let target = LogTarget()
+
+    runtime.addPlans([Log(entry: "a"), LogReplayable(entry: "r"), Log(entry: "b")], to: target)
+
+    XCTAssertEqual(target.log, ["batch a", "r", "batch b"])
+  }
+
+  func testEquatableReplayablePlansAreDeduplicated() {
+    let runtime = MotionRuntime()
+    runtime.deduplicatesEquatablePlans = true
+    Expand.expansionCount = 0
+    let first = LogTarget()
+    let second = LogTarget()
+
+    runtime.addPlan(EquatableExpand(prefix: "x"), to: first)
+    runtime.addPlan(EquatableExpand(prefix: "x"), to: first)
+    runtime.addPlan(EquatableExpand(prefix: "x"), to: second)
+    runtime.addPlan(EquatableExpand(prefix: "x"), to: second)
+
+    XCTAssertEqual(first.log, ["batch x1 x2"])
+    XCTAssertEqual(second.log, ["batch x1 x2"])
+    XCTAssertEqual(runtime.replayedPlanTemplateCount, 1)
+    XCTAssertEqual(runtime.deduplicatedPlanCount, 2)
+  }
+
+  func testPlansReplayedFromATemplateAreTokenized() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let first = SpringTarget()
+    let second = SpringTarget()
+
+    runtime.addPlan(EmitSpring(), to: first)
+    runtime.addPlan(EmitSpring(), to: second)
+
+    // Only the template's spring has a token. The replayed plan itself is not tokenized.
+    XCTAssertEqual(runtime.replayedPlanTemplateCount, 1)
+    XCTAssertEqual(runtime.activeTokenCount(for: first), 1)
+    XCTAssertEqual(runtime.activeTokenCount(for: second), 1)
+
+    for _ in 0..<600 where runtime.isActive {
+      clock.advance(by: 1.0 / 60.0)
+    }
+    XCTAssertEqual(second.x, 1)
+    XCTAssertEqual(runtime.activeTokenCount(for: second), 0)
+  }
+
+  private class LogTarget: NSObject {
+    var log: [String] = []
+  }
+
+  private class SpringTarget: NSObject {
+    var x = 0.0
+  }
+
+  private class DropTracer: NSObject, Tracing {
+    var droppedPlanCount = 0
+    func didDropEmittedPlan(_ plan: Plan, to target: Any) {
+      droppedPlanCount += 1
+    }
+  }
+
+  private class Log: NSObject, Plan {
+    let entry: String
+
+    init(entry: String) {
+      self.entry = entry
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return Log(entry: entry)
+    }
+
+    private class Performer: NSObject, Performing {
+      let target: LogTarget
+      required init(target: Any) {
+        self.target = target as! LogTarget
+      }
+
+      func addPlan(_ plan: Plan) {
+        target.log.append((plan as! Log).entry)
+      }
+
+      func addPlans(_ plans: [Plan]) {
+        let entries = plans.map { ($0 as! Log).entry }
+        target.log.append((["batch"] + entries).joined(separator: " "))
+      }
+    }
+  }
+
+  private class EmitThenLog: NSObject, Plan {
+    let plan: Plan
+    let entry: String
+
+    init(plan: Plan, entry: String) {
+      self.plan = plan
+      self.entry = entry
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return EmitThenLog(plan: plan, entry: entry)
+    }
+
+    private class Performer: NSObject, ComposablePerforming {
+      let target: LogTarget
+      required init(target: Any) {
+        self.target = target as! LogTarget
+      }
+
+      func addPlan(_ plan: Plan) {
+        let emitThenLog = plan as! EmitThenLog
+        emitter.emitPlan(emitThenLog.plan)
+        target.log.append(emitThenLog.entry)
+      }
+
+      var emitter: PlanEmitting!
+      func setPlanEmitter(_ planEmitter: PlanEmitting) {
+        emitter = planEmitter
+      }
+    }
+  }
+
+  private class EmitAll: NSObject, Plan {
+    let plans: [Plan]
+
+    init(plans: [Plan]) {
+      self.plans = plans
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return EmitAll(plans: plans)
+    }
+
+    private class Performer: NSObject, ComposablePerforming {
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+        for child in (plan as! EmitAll).plans {
+          emitter.emitPlan(child)
+        }
+      }
+
+      var emitter: PlanEmitting!
+      func setPlanEmitter(_ planEmitter: PlanEmitting) {
+        emitter = planEmitter
+      }
+    }
+  }
+
+  private class Expand: NSObject, ReplayablePlan {
+    static var expansionCount = 0
+    let prefix: String
+
+    init(prefix: String) {
+      self.prefix = prefix
+    }
+
+    override func isEqual(_ object: Any?) -> Bool {
+      return (object as? Expand)?.prefix == prefix
+    }
+
+    override var hash: Int {
+      return prefix.hashValue
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return Expand(prefix: prefix)
+    }
+
+    private class Performer: NSObject, ComposablePerforming {
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+        Expand.expansionCount += 1
+        let prefix = (plan as! Expand).prefix
+        emitter.emitPlan(Log(entry: prefix + "1"))
+        emitter.emitPlan(Log(entry: prefix + "2"))
+      }
+
+      var emitter: PlanEmitting!
+      func setPlanEmitter(_ planEmitter: PlanEmitting) {
+        emitter = planEmitter
+      }
+    }
+  }
+
+  private class EquatableExpand: Expand, EquatablePlan {
+    override func copy(with zone: NSZone? = nil) -> Any {
+      return EquatableExpand(prefix: prefix)
+    }
+  }
+
+  // Logs its entry when its performer runs. Never replayed from a template, since it emits nothing.
+  private class LogReplayable: NSObject, ReplayablePlan {
+    let entry: String
+
+    init(entry: String) {
+      self.entry = entry
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return LogReplayable(entry: entry)
+    }
+
+    private class Performer: NSObject, Performing {
+      let target: LogTarget
+      required init(target: Any) {
+        self.target = target as! LogTarget
+      }
+
+      func addPlan(_ plan: Plan) {
+        target.log.append((plan as! LogReplayable).entry)
+      }
+    }
+  }
+
+  private class EmitSpring: NSObject, ReplayablePlan {
+    override func isEqual(_ object: Any?) -> Bool {
+      return object is EmitSpring
+    }
+
+    override var hash: Int {
+      return 0
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return EmitSpring()
+    }
+
+    private class Performer: NSObject, ComposablePerforming {
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+        emitter.emitPlan(Spring(keyPath: "x", destination: 1))
+      }
+
+      var emitter: PlanEmitting!
+      func setPlanEmitter(_ planEmitter: PlanEmitting) {
+        emitter = planEmitter
+      }
+    }
+  }
+
+  private class EmitForever: NSObject, Plan {
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return EmitForever()
+    }
+
+    private class Performer: NSObject, ComposablePerforming {
+      let target: LogTarget
+      required init(target: Any) {
+        self.target = target as! LogTarget
+      }
+
+      func addPlan(_ plan: Plan) {
+        target.log.append("emit")
+        emitter.emitPlan(EmitForever())
+      }
+
+      var emitter: PlanEmitting!
+      func setPlanEmitter(_ planEmitter: PlanEmitting) {
+        emitter = planEmitter
+      }
+    }
+  }
 }
@@ -44,4 +44,80 @@ class ContinuousPerformingTests: XCTestCase {
     XCTAssertTrue(delegate.activityStateDidChange)
     XCTAssertTrue(runtime.isActive)
   }
+
+  func testActiveTokenCountIsTrackedPerTarget() {
+    let runtime = MotionRuntime()
+    let target = NSObject()
+    let otherTarget = NSObject()
+
+    runtime.addPlan(ForeverActive(), to: target)
+    runtime.addPlan(ForeverActive(), to: target)
+    runtime.addPlan(InstantlyInactive(), to: otherTarget)
+
+    XCTAssertEqual(runtime.activeTokenCount(for: target), 2)
+    XCTAssertEqual(runtime.activeTokenCount(for: otherTarget), 0)
+    XCTAssertEqual(runtime.activeTokenCount(for: NSObject()), 0)
+  }
+
+  func testClockCoalescingSuppressesTransientActivity() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.activityNotificationClock = clock
+    runtime.activityNotificationCoalescing = .clock
+
+    let delegate = ExpectableRuntimeDelegate()
+    runtime.delegate = delegate
+
+    runtime.addPlan(InstantlyInactive(), to: NSObject())
+    XCTAssertFalse(delegate.activityStateDidChange)
+
+    clock.advance(by: 1.0 / 60.0)
+    XCTAssertFalse(delegate.activityStateDidChange)
+  }
+
+  func testClockCoalescingDeliversOnTick() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.activityNotificationClock = clock
+    runtime.activityNotificationCoalescing = .clock
+
+    let delegate = ExpectableRuntimeDelegate()
+    runtime.delegate = delegate
+
+    runtime.addPlan(ForeverActive(), to: NSObject())
+    XCTAssertFalse(delegate.activityStateDidChange)
+
+    clock.advance(by: 1.0 / 60.0)
+    XCTAssertTrue(delegate.activityStateDidChange)
+    XCTAssertTrue(runtime.isActive)
+  }
+
+  func testClockCoalescingWithoutAClockFallsBackToTheRunLoop() {
+    let runtime = MotionRuntime()
+    runtime.activityNotificationCoalescing = .clock
+
+    let delegate = ExpectableRuntimeDelegate()
+    runtime.delegate = delegate
+
+    runtime.addPlan(ForeverActive(), to: NSObject())
+    XCTAssertFalse(delegate.activityStateDidChange)
+
+    RunLoop.current.run(until: Date())
+    XCTAssertTrue(delegate.activityStateDidChange)
+  }
+
+  func testClearingTheClockDeliversAPendingChange() {
+    let runtime = MotionRuntime()
+    runtime.activityNotificationClock = VirtualClock()
+    runtime.activityNotificationCoalescing = .clock
+
+    let delegate = ExpectableRuntimeDelegate()
+    runtime.delegate = delegate
+
+    runtime.addPlan(ForeverActive(), to: NSObject())
+    runtime.activityNotificationClock = nil
+
+    RunLoop.current.run(until: Date())
+    XCTAssertTrue(delegate.activityStateDidChange)
+  }
 }
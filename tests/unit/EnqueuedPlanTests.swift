@@ -0,0 +1,126 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+// Tests related to submitting plans from background threads.
+class EnqueuedPlanTests: XCTestCase {
+
+  func testEnqueuedPlansAreNotAddedUntilDrained() {
+    let runtime = MotionRuntime()
+    let target = ValuesTarget()
+
+    runtime.enqueuePlan(AppendValue(value: 1), to: target)
+    XCTAssertEqual(target.values, [])
+
+    runtime.drainEnqueuedPlans()
+    XCTAssertEqual(target.values, [1])
+  }
+
+  func testEnqueuedPlansAreDrainedByTheRunLoop() {
+    let runtime = MotionRuntime()
+    let target = ValuesTarget()
+
+    runtime.enqueuePlan(AppendValue(value: 1), to: target)
+    RunLoop.current.run(until: Date())
+
+    XCTAssertEqual(target.values, [1])
+  }
+
+  func testEnqueuedRemovalIsOrderedAfterEnqueuedAddition() {
+    let runtime = MotionRuntime()
+    let target = ValuesTarget()
+
+    runtime.enqueuePlan(NamedValue(value: 1), named: "value", to: target)
+    runtime.enqueueRemovePlan(named: "value", from: target)
+    runtime.drainEnqueuedPlans()
+
+    XCTAssertEqual(target.values, [1, -1])
+  }
+
+  func testManyProducersPreservePerTargetOrder() {
+    let runtime = MotionRuntime()
+    let producerCount = 8
+    let plansPerProducer = 2000
+    let targets = (0..<producerCount).map { _ in ValuesTarget() }
+
+    let group = DispatchGroup()
+    for producer in 0..<producerCount {
+      DispatchQueue.global().async(group: group) {
+        for value in 0..<plansPerProducer {
+          runtime.enqueuePlan(AppendValue(value: value), to: targets[producer])
+        }
+      }
+    }
+    // Drain while the producers are still running so that drains end early on commands whose
+    // producers have not linked them yet.
+    while group.wait(timeout: .now()) == .timedOut {
+      runtime.drainEnqueuedPlans()
+    }
+
+    // Every command enqueued after the last drain must have scheduled another drain.
+    RunLoop.current.run(until: Date())
+
+    for target in targets {
+      XCTAssertEqual(target.values, Array(0..<plansPerProducer))
+    }
+  }
+
+  func testDrainingFromWithinAnEnqueuedPlanExecutesEachPlanOnce() {
+    let runtime = MotionRuntime()
+    let target = ValuesTarget()
+
+    runtime.enqueuePlan(AppendValue(value: 1), to: target)
+    runtime.enqueuePlan(DrainEnqueuedPlans(runtime: runtime), to: target)
+    runtime.enqueuePlan(AppendValue(value: 2), to: target)
+    runtime.enqueuePlan(AppendValue(value: 3), to: target)
+    runtime.drainEnqueuedPlans()
+
+    XCTAssertEqual(target.values, [1, 2, 3])
+
+    runtime.enqueuePlan(AppendValue(value: 4), to: target)
+    runtime.drainEnqueuedPlans()
+
+    XCTAssertEqual(target.values, [1, 2, 3, 4])
+  }
+
+  private class DrainEnqueuedPlans: NSObject, Plan {
+    weak var runtime: MotionRuntime?
+
+    init(runtime: MotionRuntime) {
+      self.runtime = runtime
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return DrainEnqueuedPlans(runtime: runtime!)
+    }
+
+    private class Performer: NSObject, Performing {
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+        (plan as! DrainEnqueuedPlans).runtime?.drainEnqueuedPlans()
+      }
+    }
+  }
+}
@@ -0,0 +1,277 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+class FrameSchedulerTests: XCTestCase {
+
+  func testSteppersAreSteppedOnEveryTickUntilRest() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let target = Counter()
+
+    runtime.addPlan(Countdown(steps: 3), to: target)
+    XCTAssertTrue(runtime.isActive)
+    XCTAssertEqual(runtime.scheduledStepperCount, 1)
+
+    clock.advance(by: 0.016)
+    clock.advance(by: 0.016)
+    XCTAssertEqual(target.steps, 2)
+    XCTAssertTrue(runtime.isActive)
+
+    clock.advance(by: 0.016)
+    XCTAssertEqual(target.steps, 3)
+    XCTAssertFalse(runtime.isActive)
+    XCTAssertEqual(runtime.scheduledStepperCount, 0)
+
+    clock.advance(by: 0.016)
+    XCTAssertEqual(target.steps, 3)
+  }
+
+  func testSteppersReceiveTheTimeSinceThePreviousTick() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    clock.advance(by: 1)
+    runtime.frameClock = clock
+    let target = Counter()
+
+    runtime.addPlan(Countdown(steps: 2), to: target)
+    clock.advance(by: 0.25)
+    clock.advance(by: 0.5)
+
+    XCTAssertEqual(target.intervals, [0.25, 0.5])
+  }
+
+  func testSteppersAreNotSteppedWithoutAClock() {
+    let runtime = MotionRuntime()
+    let target = Counter()
+
+    runtime.addPlan(Countdown(steps: 1), to: target)
+
+    XCTAssertEqual(target.steps, 0)
+    XCTAssertTrue(runtime.isActive)
+    XCTAssertEqual(runtime.scheduledStepperCount, 1)
+  }
+
+  func testUnschedulingDeactivatesTheToken() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let target = Counter()
+
+    runtime.addPlan(Countdown(steps: 10), named: "countdown", to: target)
+    clock.advance(by: 0.016)
+    runtime.removePlan(named: "countdown", from: target)
+    clock.advance(by: 0.016)
+
+    XCTAssertEqual(target.steps, 1)
+    XCTAssertFalse(runtime.isActive)
+    XCTAssertEqual(runtime.scheduledStepperCount, 0)
+  }
+
+  func testSteppersOfDifferentClassesAreSteppedOnTheSameTick() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let targets = (0..<4).map { _ in Counter() }
+
+    for (index, target) in targets.enumerated() {
+      if index % 2 == 0 {
+        runtime.addPlan(Countdown(steps: 2), to: target)
+      } else {
+        runtime.addPlan(Countup(steps: 1), to: target)
+      }
+    }
+    XCTAssertEqual(runtime.scheduledStepperCount, 4)
+
+    clock.advance(by: 0.016)
+    XCTAssertEqual(targets.map { $0.steps }, [1, -1, 1, -1])
+    XCTAssertEqual(runtime.scheduledStepperCount, 2)
+    XCTAssertTrue(runtime.isActive)
+
+    clock.advance(by: 0.016)
+    XCTAssertEqual(targets.map { $0.steps }, [2, -1, 2, -1])
+    XCTAssertFalse(runtime.isActive)
+  }
+
+  func testRestingSteppersCanBeRescheduledDuringDeactivation() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let target = Counter()
+    let delegate = RestartingDelegate(target: target)
+    runtime.delegate = delegate
+
+    runtime.addPlan(Countdown(steps: 1), to: target)
+    clock.advance(by: 0.016)
+    XCTAssertEqual(target.steps, 1)
+    XCTAssertEqual(runtime.scheduledStepperCount, 1)
+
+    clock.advance(by: 0.016)
+    XCTAssertEqual(target.steps, 2)
+  }
+}
+
+private class Counter: NSObject {
+  var steps = 0
+  var intervals: [TimeInterval] = []
+}
+
+private class RestartingDelegate: NSObject, MotionRuntimeDelegate {
+  let target: Counter
+  var restarted = false
+
+  init(target: Counter) {
+    self.target = target
+  }
+
+  func motionRuntimeActivityStateDidChange(_ runtime: MotionRuntime) {
+    if !runtime.isActive && !restarted {
+      restarted = true
+      runtime.addPlan(Countdown(steps: 1), to: target)
+    }
+  }
+}
+
+private class Countdown: NSObject, NamedPlan {
+  let steps: Int
+
+  init(steps: Int) {
+    self.steps = steps
+  }
+
+  func performerClass() -> AnyClass {
+    return Performer.self
+  }
+
+  public func copy(with zone: NSZone? = nil) -> Any {
+    return Countdown(steps: steps)
+  }
+
+  private class Stepper: NSObject, FrameStepping {
+    let target: Counter
+    var remaining: Int
+
+    init(target: Counter, steps: Int) {
+      self.target = target
+      self.remaining = steps
+    }
+
+    func step(by interval: TimeInterval) -> Bool {
+      target.steps += 1
+      target.intervals.append(interval)
+      remaining -= 1
+      return remaining == 0
+    }
+  }
+
+  private class Performer: NSObject, FrameScheduledPerforming, NamedPlanPerforming {
+    let target: Counter
+    var steppers: [String: Stepper] = [:]
+
+    required init(target: Any) {
+      self.target = target as! Counter
+    }
+
+    func addPlan(_ plan: Plan) {
+      let countdown = plan as! Countdown
+      frameScheduler.schedule(Stepper(target: target, steps: countdown.steps),
+                              token: planTokenizer.token(for: plan))
+    }
+
+    func addPlan(_ plan: NamedPlan, named name: String) {
+      let countdown = plan as! Countdown
+      let stepper = Stepper(target: target, steps: countdown.steps)
+      steppers[name] = stepper
+      frameScheduler.schedule(stepper, token: planTokenizer.token(for: plan))
+    }
+
+    func removePlan(named name: String) {
+      if let stepper = steppers.removeValue(forKey: name) {
+        frameScheduler.unschedule(stepper)
+      }
+    }
+
+    var planTokenizer: PlanTokenizing!
+    func givePlanTokenizer(_ planTokenizer: PlanTokenizing) {
+      self.planTokenizer = planTokenizer
+    }
+
+    var frameScheduler: FrameScheduling!
+    func setFrameScheduler(_ frameScheduler: FrameScheduling) {
+      self.frameScheduler = frameScheduler
+    }
+  }
+}
+
+private class Countup: NSObject, Plan {
+  let steps: Int
+
+  init(steps: Int) {
+    self.steps = steps
+  }
+
+  func performerClass() -> AnyClass {
+    return Performer.self
+  }
+
+  public func copy(with zone: NSZone? = nil) -> Any {
+    return Countup(steps: steps)
+  }
+
+  private class Stepper: NSObject, FrameStepping {
+    let target: Counter
+    var remaining: Int
+
+    init(target: Counter, steps: Int) {
+      self.target = target
+      self.remaining = steps
+    }
+
+    func step(by interval: TimeInterval) -> Bool {
+      target.steps -= 1
+      remaining -= 1
+      return remaining == 0
+    }
+  }
+
+  private class Performer: NSObject, FrameScheduledPerforming {
+    let target: Counter
+
+    required init(target: Any) {
+      self.target = target as! Counter
+    }
+
+    func addPlan(_ plan: Plan) {
+      let countup = plan as! Countup
+      frameScheduler.schedule(Stepper(target: target, steps: countup.steps),
+                              token: planTokenizer.token(for: plan))
+    }
+
+    var planTokenizer: PlanTokenizing!
+    func givePlanTokenizer(_ planTokenizer: PlanTokenizing) {
+      self.planTokenizer = planTokenizer
+    }
+
+    var frameScheduler: FrameScheduling!
+    func setFrameScheduler(_ frameScheduler: FrameScheduling) {
+      self.frameScheduler = frameScheduler
+    }
+  }
+}
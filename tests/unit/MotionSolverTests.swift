@@ -0,0 +1,235 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+class MotionSolverTests: XCTestCase {
+
+  func testSpringComesToRestAtItsDestination() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let box = Box()
+
+    runtime.addPlan(Spring(keyPath: "x", destination: 100), to: box)
+    XCTAssertTrue(runtime.isActive)
+
+    clock.advance(by: 1.0 / 60.0)
+    XCTAssertGreaterThan(box.x, 0)
+    XCTAssertLessThan(box.x, 100)
+
+    settle(runtime, clock)
+    XCTAssertEqual(box.x, 100)
+    XCTAssertFalse(runtime.isActive)
+    XCTAssertEqual(runtime.scheduledStepperCount, 0)
+  }
+
+  func testRetargetingASpringPreservesItsVelocity() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let box = Box()
+
+    runtime.addPlan(Spring(keyPath: "x", destination: 100), to: box)
+    for _ in 0..<5 {
+      clock.advance(by: 1.0 / 60.0)
+    }
+    let position = box.x
+
+    runtime.addPlan(Spring(keyPath: "x", destination: 0), to: box)
+    clock.advance(by: 1.0 / 60.0)
+    XCTAssertGreaterThan(box.x, position)
+
+    settle(runtime, clock)
+    XCTAssertEqual(box.x, 0)
+    XCTAssertFalse(runtime.isActive)
+  }
+
+  func testTweenReachesItsEndValueAfterItsDuration() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let box = Box()
+
+    runtime.addPlan(Tween(keyPath: "x", from: 0, to: 10, duration: 0.5, timingFunction: .linear),
+                    to: box)
+    clock.advance(by: 0.25)
+    XCTAssertEqualWithAccuracy(box.x, 5, accuracy: 0.0001)
+    XCTAssertTrue(runtime.isActive)
+
+    clock.advance(by: 0.25)
+    XCTAssertEqual(box.x, 10)
+    XCTAssertFalse(runtime.isActive)
+  }
+
+  func testTweenReplacesASpringOnTheSameKeyPath() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let box = Box()
+
+    runtime.addPlan(Spring(keyPath: "x", destination: 100), to: box)
+    clock.advance(by: 1.0 / 60.0)
+    runtime.addPlan(Tween(keyPath: "x", from: 50, to: 60, duration: 0.1), to: box)
+    clock.advance(by: 0.1)
+
+    XCTAssertEqual(box.x, 60)
+    XCTAssertFalse(runtime.isActive)
+  }
+
+  func testValuesAreWrittenToFloatAndNestedKeyPaths() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let box = Box()
+
+    runtime.addPlan(Tween(keyPath: "width", from: 0, to: 10, duration: 0.5,
+                          timingFunction: .linear),
+                    to: box)
+    runtime.addPlan(Tween(keyPath: "inner.x", from: 0, to: 10, duration: 0.5,
+                          timingFunction: .linear),
+                    to: box)
+    clock.advance(by: 0.25)
+
+    XCTAssertEqualWithAccuracy(box.width, 5, accuracy: 0.0001)
+    XCTAssertEqualWithAccuracy(box.inner.x, 5, accuracy: 0.0001)
+  }
+
+  func testRemovingANamedSpringStopsItsMotion() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let box = Box()
+
+    runtime.addPlan(Spring(keyPath: "x", destination: 100), named: "spring", to: box)
+    clock.advance(by: 1.0 / 60.0)
+    runtime.removePlan(named: "spring", from: box)
+    XCTAssertFalse(runtime.isActive)
+
+    let position = box.x
+    clock.advance(by: 1.0 / 60.0)
+    XCTAssertEqual(box.x, position)
+  }
+
+  func testRemovingAReplacedNamedSpringLeavesTheNewerMotionRunning() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let box = Box()
+
+    runtime.addPlan(Spring(keyPath: "x", destination: 100), named: "first", to: box)
+    runtime.addPlan(Spring(keyPath: "x", destination: 50), named: "second", to: box)
+    runtime.removePlan(named: "first", from: box)
+    XCTAssertTrue(runtime.isActive)
+
+    settle(runtime, clock)
+    XCTAssertEqual(box.x, 50)
+
+    runtime.removePlan(named: "second", from: box)
+    XCTAssertFalse(runtime.isActive)
+  }
+
+  func testReplacingANamedSpringMidFlightPreservesItsVelocityAndToken() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let delegate = ActivityCountingDelegate()
+    runtime.delegate = delegate
+    let replaced = Box()
+    let reference = Box()
+
+    runtime.addPlan(Spring(keyPath: "x", destination: 100), named: "drag", to: replaced)
+    runtime.addPlan(Spring(keyPath: "x", destination: 100), to: reference)
+    for _ in 0..<5 {
+      clock.advance(by: 1.0 / 60.0)
+      // A gesture re-adds its spring on every frame.
+      runtime.addPlan(Spring(keyPath: "x", destination: 100), named: "drag", to: replaced)
+      XCTAssertEqual(runtime.activeTokenCount(for: replaced), 1)
+    }
+    clock.advance(by: 1.0 / 60.0)
+
+    XCTAssertGreaterThan(replaced.x, 0)
+    XCTAssertEqual(replaced.x, reference.x)
+    XCTAssertEqual(delegate.activityStateChangeCount, 1)
+  }
+
+  func testOneSpringAddedToTwoTargetsHasATokenPerTarget() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    let settled = Box()
+    settled.x = 100
+    let moving = Box()
+
+    let spring = Spring(keyPath: "x", destination: 100)
+    runtime.addPlan(spring, to: settled)
+    runtime.addPlan(spring, to: moving)
+    XCTAssertEqual(runtime.activeTokenCount(for: settled), 1)
+    XCTAssertEqual(runtime.activeTokenCount(for: moving), 1)
+
+    clock.advance(by: 1.0 / 60.0)
+    XCTAssertEqual(runtime.activeTokenCount(for: settled), 0)
+    XCTAssertEqual(runtime.activeTokenCount(for: moving), 1)
+    XCTAssertTrue(runtime.isActive)
+
+    settle(runtime, clock)
+    XCTAssertEqual(moving.x, 100)
+    XCTAssertFalse(runtime.isActive)
+  }
+
+  func testEverySpringOfEveryTargetComesToRest() {
+    let runtime = MotionRuntime()
+    let clock = VirtualClock()
+    runtime.frameClock = clock
+    // Not a multiple of any vector width, so that the scalar remainder is exercised.
+    let boxes = (0..<13).map { _ in Box() }
+
+    for (index, box) in boxes.enumerated() {
+      runtime.addPlan(Spring(keyPath: "x", destination: Double(index)), to: box)
+      runtime.addPlan(Tween(keyPath: "y", from: 0, to: 1, duration: Double(index) * 0.1), to: box)
+    }
+    settle(runtime, clock)
+
+    XCTAssertEqual(boxes.map { $0.x }, (0..<13).map { Double($0) })
+    XCTAssertEqual(boxes.map { $0.y }, Array(repeating: 1, count: 13))
+  }
+
+  private func settle(_ runtime: MotionRuntime, _ clock: VirtualClock) {
+    for _ in 0..<600 where runtime.isActive {
+      clock.advance(by: 1.0 / 60.0)
+    }
+  }
+}
+
+private class ActivityCountingDelegate: NSObject, MotionRuntimeDelegate {
+  var activityStateChangeCount = 0
+  func motionRuntimeActivityStateDidChange(_ runtime: MotionRuntime) {
+    activityStateChangeCount += 1
+  }
+}
+
+private class Box: NSObject {
+  var x = 0.0
+  var y = 0.0
+  var width: Float = 0
+  var inner = InnerBox()
+}
+
+private class InnerBox: NSObject {
+  var x = 0.0
+}
@@ -200,9 +200,257 @@ class NamedPlanTests: XCTestCase {
     ]))
   }
 
+  func testPlanNamesAreInterned() {
+    let name = PlanName("interned_name")
+
+    XCTAssertTrue(name === PlanName("interned_name"))
+    XCTAssertTrue(name === PlanName.existing("interned_name"))
+    XCTAssertNotEqual(name.identifier, PlanName("other_interned_name").identifier)
+    XCTAssertEqual(name.string, "interned_name")
+  }
+
+  func testPlanNameHandlesAndStringsAddressTheSamePlan() {
+    let runtime = MotionRuntime()
+    let name = PlanName("handle_name")
+    runtime.addPlan(IncrementerTargetPlan(), named: name, to: incrementerTarget)
+    runtime.addPlan(IncrementerTargetPlan(), named: "handle_name", to: incrementerTarget)
+    runtime.removePlan(named: name, from: incrementerTarget)
+
+    XCTAssertTrue(incrementerTarget.addCounter == 2)
+    XCTAssertTrue(incrementerTarget.removeCounter == 2)
+  }
+
+  func testStringNamesAreReleasedOnceNoPlanUsesThem() {
+    let runtime = MotionRuntime()
+    autoreleasepool {
+      runtime.addPlan(IncrementerTargetPlan(), named: "transient_name", to: incrementerTarget)
+      XCTAssertNotNil(PlanName.existing("transient_name"))
+    }
+    autoreleasepool {
+      runtime.removePlan(named: "transient_name", from: incrementerTarget)
+    }
+    autoreleasepool {
+      XCTAssertNil(PlanName.existing("transient_name"))
+    }
+
+    let name = PlanName("permanent_name")
+    autoreleasepool {
+      runtime.addPlan(IncrementerTargetPlan(), named: "permanent_name", to: incrementerTarget)
+      runtime.removePlan(named: "permanent_name", from: incrementerTarget)
+    }
+    XCTAssertTrue(PlanName.existing("permanent_name") === name)
+    XCTAssertTrue(incrementerTarget.removeCounter == 2)
+  }
+
+  func testTransactionAppliesOnlyTheFinalNamedPlan() {
+    let runtime = MotionRuntime()
+    runtime.beginTransaction()
+    for _ in 0..<10 {
+      runtime.addPlan(IncrementerTargetPlan(), named: "drag", to: incrementerTarget)
+    }
+    XCTAssertTrue(incrementerTarget.addCounter == 0)
+    runtime.commitTransaction()
+
+    XCTAssertTrue(incrementerTarget.addCounter == 1)
+    XCTAssertTrue(incrementerTarget.removeCounter == 0)
+  }
+
+  func testTransactionDropsAdditionsThatAreRemoved() {
+    let runtime = MotionRuntime()
+    runtime.beginTransaction()
+    runtime.addPlan(IncrementerTargetPlan(), named: "drag", to: incrementerTarget)
+    runtime.removePlan(named: "drag", from: incrementerTarget)
+    runtime.commitTransaction()
+
+    XCTAssertTrue(incrementerTarget.addCounter == 0)
+    XCTAssertTrue(incrementerTarget.removeCounter == 0)
+  }
+
+  func testNestedTransactionsApplyOnOutermostCommit() {
+    let runtime = MotionRuntime()
+    runtime.beginTransaction()
+    runtime.beginTransaction()
+    runtime.addPlan(IncrementerTargetPlan(), named: "drag", to: incrementerTarget)
+    runtime.commitTransaction()
+    XCTAssertTrue(incrementerTarget.addCounter == 0)
+    runtime.commitTransaction()
+
+    XCTAssertTrue(incrementerTarget.addCounter == 1)
+  }
+
+  func testReplacingPerformerReceivesOneCallback() {
+    let runtime = MotionRuntime()
+    runtime.addPlan(ReplaceablePlan(), named: "drag", to: incrementerTarget)
+    runtime.addPlan(ReplaceablePlan(), named: "drag", to: incrementerTarget)
+
+    XCTAssertTrue(incrementerTarget.addCounter == 1)
+    XCTAssertTrue(incrementerTarget.replaceCounter == 1)
+    XCTAssertTrue(incrementerTarget.removeCounter == 0)
+  }
+
+  func testScopeWithoutPlansIsReclaimed() {
+    let runtime = MotionRuntime()
+    let tracer = PerformerCreationTracer()
+    runtime.addTracer(tracer)
+
+    runtime.addPlan(IncrementerTargetPlan(), named: "one", to: incrementerTarget)
+    runtime.removePlan(named: "one", from: incrementerTarget)
+    runtime.addPlan(IncrementerTargetPlan(), named: "one", to: incrementerTarget)
+
+    XCTAssertEqual(tracer.performerCount, 2)
+  }
+
+  func testScopeWithUnnamedPlansIsNotReclaimed() {
+    let runtime = MotionRuntime()
+    let tracer = PerformerCreationTracer()
+    runtime.addTracer(tracer)
+
+    runtime.addPlan(IncrementerTargetPlan(), to: incrementerTarget)
+    runtime.addPlan(IncrementerTargetPlan(), named: "one", to: incrementerTarget)
+    runtime.removePlan(named: "one", from: incrementerTarget)
+    runtime.addPlan(IncrementerTargetPlan(), named: "one", to: incrementerTarget)
+
+    XCTAssertEqual(tracer.performerCount, 1)
+  }
+
+  func testRemovingFromUnknownTargetCreatesNoPerformers() {
+    let runtime = MotionRuntime()
+    let tracer = PerformerCreationTracer()
+    runtime.addTracer(tracer)
+
+    for _ in 0..<100 {
+      runtime.removePlan(named: "one", from: IncrementerTarget())
+    }
+
+    XCTAssertEqual(tracer.performerCount, 0)
+  }
+
+  func testEmitterOfReclaimedScopeDoesNotEmitToTheScopesNextTarget() {
+    let runtime = MotionRuntime()
+    let holder = EmitterHolder()
+    var firstTarget: IncrementerTarget? = IncrementerTarget()
+
+    runtime.addPlan(EmitterCapturingPlan(holder: holder), named: "one", to: firstTarget!)
+    runtime.removePlan(named: "one", from: firstTarget!)
+    firstTarget = nil
+
+    // Reuses the reclaimed scope.
+    runtime.addPlan(IncrementerTargetPlan(), named: "one", to: incrementerTarget)
+    XCTAssertEqual(incrementerTarget.addCounter, 1)
+
+    holder.emitter!.emitPlan(UnnamedIncrementerPlan())
+    XCTAssertEqual(incrementerTarget.addCounter, 1)
+  }
+
+  private class EmitterHolder {
+    var emitter: PlanEmitting?
+  }
+
+  private class EmitterCapturingPlan: NSObject, NamedPlan {
+    let holder: EmitterHolder
+
+    init(holder: EmitterHolder) {
+      self.holder = holder
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return EmitterCapturingPlan(holder: holder)
+    }
+
+    private class Performer: NSObject, NamedPlanPerforming, ComposablePerforming {
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+      }
+
+      func addPlan(_ plan: NamedPlan, named name: String) {
+        (plan as! EmitterCapturingPlan).holder.emitter = emitter
+      }
+
+      func removePlan(named name: String) {
+      }
+
+      var emitter: PlanEmitting!
+      func setPlanEmitter(_ planEmitter: PlanEmitting) {
+        emitter = planEmitter
+      }
+    }
+  }
+
+  private class UnnamedIncrementerPlan: NSObject, Plan {
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return UnnamedIncrementerPlan()
+    }
+
+    private class Performer: NSObject, Performing {
+      let target: Any
+      required init(target: Any) {
+        self.target = target
+      }
+
+      func addPlan(_ plan: Plan) {
+        if let unwrappedTarget = self.target as? IncrementerTarget {
+          unwrappedTarget.addCounter = unwrappedTarget.addCounter + 1
+        }
+      }
+    }
+  }
+
+  private class PerformerCreationTracer: NSObject, Tracing {
+    var performerCount = 0
+    func didCreatePerformer(_ performer: Performing, for target: Any) {
+      performerCount += 1
+    }
+  }
+
   private class IncrementerTarget: NSObject {
     var addCounter = 0
     var removeCounter = 0
+    var replaceCounter = 0
+  }
+
+  private class ReplaceablePlan: NSObject, NamedPlan {
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return ReplaceablePlan()
+    }
+
+    private class Performer: NSObject, NamedPlanPerforming {
+      let target: IncrementerTarget
+      required init(target: Any) {
+        self.target = target as! IncrementerTarget
+      }
+
+      public func addPlan(_ plan: Plan) {
+        // No-op
+      }
+
+      func addPlan(_ plan: NamedPlan, named name: String) {
+        target.addCounter += 1
+      }
+
+      func removePlan(named name: String) {
+        target.removeCounter += 1
+      }
+
+      func replacePlan(named name: String, with plan: NamedPlan) {
+        target.replaceCounter += 1
+      }
+    }
   }
 
   private class RegularPlanTargetAlteringPlan: NSObject, NamedPlan {
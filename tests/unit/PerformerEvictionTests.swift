@@ -0,0 +1,116 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+// Tests related to evicting idle performers under a performer budget.
+class PerformerEvictionTests: XCTestCase {
+
+  func testIdleRehydratablePerformersAreEvictedAndRehydrated() {
+    let runtime = MotionRuntime()
+    runtime.performerBudget = 1
+    let first = ValuesTarget()
+    let second = ValuesTarget()
+
+    runtime.addPlan(RehydratableValue(value: 1), to: first)
+    runtime.addPlan(RehydratableValue(value: 10), to: second)
+
+    XCTAssertEqual(runtime.performerEvictionCount, 1)
+
+    runtime.addPlan(RehydratableValue(value: 2), to: first)
+
+    XCTAssertEqual(runtime.performerRehydrationCount, 1)
+    XCTAssertEqual(first.values, [1, 1, 2])
+    XCTAssertEqual(second.values, [10])
+  }
+
+  func testPerformersWithUnnamedPlansAreNotEvictedUnlessRehydratable() {
+    let runtime = MotionRuntime()
+    runtime.performerBudget = 1
+
+    runtime.addPlan(AppendValue(value: 1), to: ValuesTarget())
+    runtime.addPlan(AppendValue(value: 2), to: ValuesTarget())
+
+    XCTAssertEqual(runtime.performerEvictionCount, 0)
+  }
+
+  func testPerformersAreNotEvictedWithoutABudget() {
+    let runtime = MotionRuntime()
+
+    for value in 0..<10 {
+      runtime.addPlan(RehydratableValue(value: value), to: ValuesTarget())
+    }
+
+    XCTAssertEqual(runtime.performerEvictionCount, 0)
+  }
+
+  func testPlansAreOnlyRetainedWhileABudgetIsSet() {
+    let runtime = MotionRuntime()
+    let first = ValuesTarget()
+    let second = ValuesTarget()
+
+    runtime.addPlan(RehydratableValue(value: 1), to: first)
+    XCTAssertEqual(runtime.snapshot().retainedPlanCount, 0)
+
+    runtime.performerBudget = 10
+    runtime.addPlan(RehydratableValue(value: 2), to: second)
+    XCTAssertEqual(runtime.snapshot().retainedPlanCount, 1)
+  }
+
+  func testPerformersWithUnretainedPlansAreNotEvicted() {
+    let runtime = MotionRuntime()
+    let first = ValuesTarget()
+    let second = ValuesTarget()
+
+    runtime.addPlan(RehydratableValue(value: 1), to: first)
+    runtime.performerBudget = 1
+    runtime.addPlan(RehydratableValue(value: 10), to: second)
+    runtime.addPlan(RehydratableValue(value: 2), to: first)
+
+    XCTAssertEqual(runtime.performerEvictionCount, 1)
+    XCTAssertEqual(runtime.performerRehydrationCount, 0)
+    XCTAssertEqual(first.values, [1, 2])
+  }
+
+  private class RehydratableValue: NSObject, Plan {
+    let value: Int
+
+    init(value: Int) {
+      self.value = value
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return RehydratableValue(value: value)
+    }
+
+    private class Performer: NSObject, RehydratablePerforming {
+      let target: ValuesTarget
+      required init(target: Any) {
+        self.target = target as! ValuesTarget
+      }
+
+      func addPlan(_ plan: Plan) {
+        target.values.append((plan as! RehydratableValue).value)
+      }
+    }
+  }
+}
@@ -0,0 +1,133 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+// Tests related to timing performer callbacks.
+class PerformerLatencyRecorderTests: XCTestCase {
+
+  func testNoSamplesAreRecordedWithoutARecorder() {
+    let runtime = MotionRuntime()
+    let recorder = PerformerLatencyRecorder()
+
+    runtime.addPlan(Sleep(microseconds: 0), to: NSObject())
+
+    XCTAssertNil(runtime.performerLatencyRecorder)
+    XCTAssertEqual(recorder.summaries().count, 0)
+  }
+
+  func testCallbacksAreTimedPerPerformerClass() {
+    let runtime = MotionRuntime()
+    let recorder = PerformerLatencyRecorder()
+    runtime.performerLatencyRecorder = recorder
+    let target = NSObject()
+
+    for _ in 0..<3 {
+      runtime.addPlan(Sleep(microseconds: 1000), to: target)
+    }
+
+    let initSummary = recorder.summary(for: SleepPerformer.self, callback: .initWithTarget)
+    XCTAssertEqual(initSummary?.sampleCount, 1)
+
+    let summary = recorder.summary(for: SleepPerformer.self, callback: .addPlan)!
+    XCTAssertEqual(summary.sampleCount, 3)
+    XCTAssertEqual(summary.performerClassName, NSStringFromClass(SleepPerformer.self))
+    XCTAssertGreaterThanOrEqual(summary.p50Latency, 0.0009)
+    XCTAssertLessThanOrEqual(summary.p50Latency, summary.p99Latency)
+    XCTAssertLessThanOrEqual(summary.p99Latency, summary.maxLatency)
+    XCTAssertEqual(recorder.droppedSampleCount, 0)
+  }
+
+  func testNamedCallbacksAreTimed() {
+    let runtime = MotionRuntime()
+    let recorder = PerformerLatencyRecorder()
+    runtime.performerLatencyRecorder = recorder
+    let target = NSObject()
+
+    runtime.addPlan(NamedSleep(), named: "a", to: target)
+    runtime.addPlan(NamedSleep(), named: "b", to: target)
+    runtime.removePlan(named: "a", from: target)
+
+    XCTAssertEqual(recorder.summary(for: NamedSleepPerformer.self,
+                                    callback: .addPlanNamed)?.sampleCount, 2)
+    XCTAssertEqual(recorder.summary(for: NamedSleepPerformer.self,
+                                    callback: .removePlanNamed)?.sampleCount, 1)
+    XCTAssertNil(recorder.summary(for: NamedSleepPerformer.self, callback: .addPlan))
+  }
+
+  func testResetDiscardsSamples() {
+    let runtime = MotionRuntime()
+    let recorder = PerformerLatencyRecorder()
+    runtime.performerLatencyRecorder = recorder
+
+    runtime.addPlan(Sleep(microseconds: 0), to: NSObject())
+    XCTAssertGreaterThan(recorder.summaries().count, 0)
+
+    recorder.reset()
+    XCTAssertEqual(recorder.summaries().count, 0)
+  }
+
+  private class Sleep: NSObject, Plan {
+    let microseconds: UInt32
+
+    init(microseconds: UInt32) {
+      self.microseconds = microseconds
+    }
+
+    func performerClass() -> AnyClass {
+      return SleepPerformer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return Sleep(microseconds: microseconds)
+    }
+  }
+
+  private class SleepPerformer: NSObject, Performing {
+    required init(target: Any) {
+    }
+
+    func addPlan(_ plan: Plan) {
+      usleep((plan as! Sleep).microseconds)
+    }
+  }
+
+  private class NamedSleep: NSObject, NamedPlan {
+    func performerClass() -> AnyClass {
+      return NamedSleepPerformer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return NamedSleep()
+    }
+  }
+
+  private class NamedSleepPerformer: NSObject, NamedPlanPerforming {
+    required init(target: Any) {
+    }
+
+    func addPlan(_ plan: Plan) {
+    }
+
+    func addPlan(_ plan: NamedPlan, named name: String) {
+    }
+
+    func removePlan(named name: String) {
+    }
+  }
+}
@@ -0,0 +1,144 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+// Tests related to deduplicating equatable plans.
+class PlanDeduplicationTests: XCTestCase {
+
+  func testEqualPlansAreAddedWhenDeduplicationIsDisabled() {
+    let runtime = MotionRuntime()
+    let target = ValuesTarget()
+
+    runtime.addPlan(AppendValue(value: 1), to: target)
+    runtime.addPlan(AppendValue(value: 1), to: target)
+
+    XCTAssertEqual(target.values, [1, 1])
+    XCTAssertEqual(runtime.planDeduplicationLookupCount, 0)
+  }
+
+  func testEqualPlansAreSkippedPerTarget() {
+    let runtime = MotionRuntime()
+    runtime.deduplicatesEquatablePlans = true
+    let first = ValuesTarget()
+    let second = ValuesTarget()
+
+    runtime.addPlan(AppendValue(value: 1), to: first)
+    runtime.addPlan(AppendValue(value: 1), to: first)
+    runtime.addPlan(AppendValue(value: 2), to: first)
+    runtime.addPlan(AppendValue(value: 1), to: second)
+
+    XCTAssertEqual(first.values, [1, 2])
+    XCTAssertEqual(second.values, [1])
+    XCTAssertEqual(runtime.planDeduplicationLookupCount, 4)
+    XCTAssertEqual(runtime.deduplicatedPlanCount, 1)
+  }
+
+  func testRedundantBatchedPlansAreSkipped() {
+    let runtime = MotionRuntime()
+    runtime.deduplicatesEquatablePlans = true
+    let target = ValuesTarget()
+
+    runtime.addPlan(AppendValue(value: 1), to: target)
+    runtime.addPlans([AppendValue(value: 1), AppendValue(value: 2)], to: target)
+
+    XCTAssertEqual(target.values, [1, 2])
+    XCTAssertEqual(runtime.deduplicatedPlanCount, 1)
+  }
+
+  func testEqualPlansWithinOneBatchAreSkipped() {
+    let runtime = MotionRuntime()
+    runtime.deduplicatesEquatablePlans = true
+    let target = ValuesTarget()
+
+    runtime.addPlans([AppendValue(value: 1), AppendValue(value: 2), AppendValue(value: 1)],
+                     to: target)
+
+    XCTAssertEqual(target.values, [1, 2])
+    XCTAssertEqual(runtime.deduplicatedPlanCount, 1)
+    XCTAssertEqual(runtime.snapshot().tokenCount, 2)
+  }
+
+  func testRedundantPlansAreNotTokenized() {
+    let runtime = MotionRuntime()
+    runtime.deduplicatesEquatablePlans = true
+    let target = ValuesTarget()
+
+    runtime.addPlan(AppendValue(value: 1), to: target)
+    runtime.addPlan(AppendValue(value: 1), to: target)
+
+    XCTAssertEqual(runtime.deduplicatedPlanCount, 1)
+    XCTAssertEqual(target.values, [1])
+    XCTAssertEqual(runtime.snapshot().tokenCount, 1)
+  }
+
+  func testEqualPlansAreTokenizedWhenDeduplicationIsDisabled() {
+    let runtime = MotionRuntime()
+    let target = ValuesTarget()
+
+    runtime.addPlan(AppendValue(value: 1), to: target)
+    runtime.addPlan(AppendValue(value: 1), to: target)
+
+    XCTAssertEqual(runtime.deduplicatedPlanCount, 0)
+    XCTAssertEqual(target.values, [1, 1])
+    XCTAssertEqual(runtime.snapshot().tokenCount, 2)
+  }
+
+  func testEqualPlansEmittedTogetherAreDeduplicated() {
+    let runtime = MotionRuntime()
+    runtime.deduplicatesEquatablePlans = true
+    let target = ValuesTarget()
+
+    runtime.addPlan(EmitTwice(plan: AppendValue(value: 1)), to: target)
+
+    XCTAssertEqual(target.values, [1])
+    XCTAssertEqual(runtime.deduplicatedPlanCount, 1)
+  }
+
+  private class EmitTwice: NSObject, Plan {
+    let plan: Plan
+
+    init(plan: Plan) {
+      self.plan = plan
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return EmitTwice(plan: plan)
+    }
+
+    private class Performer: NSObject, ComposablePerforming {
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+        let emitTwice = plan as! EmitTwice
+        emitter.emitPlan(emitTwice.plan)
+        emitter.emitPlan(emitTwice.plan)
+      }
+
+      var emitter: PlanEmitting!
+      func setPlanEmitter(_ planEmitter: PlanEmitting) {
+        emitter = planEmitter
+      }
+    }
+  }
+}
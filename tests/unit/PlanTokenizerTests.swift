@@ -25,6 +25,123 @@ class TokenPoolTests: XCTestCase {
     runtime.addPlan(TokenFetching(), to: NSObject())
   }
 
+  func testTokenGroupNotifiesOncePerAggregateTransition() {
+    let runtime = MotionRuntime()
+    let delegate = CountingDelegate()
+    runtime.delegate = delegate
+    let target = NSObject()
+
+    runtime.addPlans([GroupMember(), GroupMember(), GroupMember()], to: target)
+
+    XCTAssertEqual(delegate.activityStateChangeCount, 2)
+    XCTAssertFalse(runtime.isActive)
+    XCTAssertEqual(runtime.activeTokenCount(for: target), 0)
+  }
+
+  func testTokenizerOnlyNeedsToProvideTokensForPlans() {
+    let tokenizer: PlanTokenizing = MinimalTokenizer()
+    XCTAssertNil(tokenizer.token(for: GroupMember()))
+    XCTAssertFalse(tokenizer.responds(to: #selector(PlanTokenizing.tokenGroup(for:))))
+  }
+
+  func testEqualPlansReceiveDistinctTokens() {
+    let runtime = MotionRuntime()
+    let target = NSObject()
+
+    runtime.addPlans([EqualPlan(), EqualPlan()], to: target)
+
+    XCTAssertEqual(runtime.snapshot().tokenCount, 2)
+  }
+
+  private class EqualPlan: NSObject, EquatablePlan {
+    override func isEqual(_ object: Any?) -> Bool {
+      return object is EqualPlan
+    }
+
+    override var hash: Int {
+      return 0
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return EqualPlan()
+    }
+
+    private class Performer: NSObject, ContinuousPerforming {
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+        addPlans([plan])
+      }
+
+      func addPlans(_ plans: [Plan]) {
+        let tokens = plans.map { planTokenizer.token(for: $0)! }
+        if tokens.count == 2 {
+          XCTAssertFalse(tokens[0] === tokens[1])
+        }
+      }
+
+      var planTokenizer: PlanTokenizing!
+      func givePlanTokenizer(_ planTokenizer: PlanTokenizing) {
+        self.planTokenizer = planTokenizer
+      }
+    }
+  }
+
+  private class MinimalTokenizer: NSObject, PlanTokenizing {
+    func token(for plan: Plan) -> Tokened? {
+      return nil
+    }
+  }
+
+  private class CountingDelegate: NSObject, MotionRuntimeDelegate {
+    var activityStateChangeCount = 0
+    func motionRuntimeActivityStateDidChange(_ runtime: MotionRuntime) {
+      activityStateChangeCount += 1
+    }
+  }
+
+  private class GroupMember: NSObject, Plan {
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return GroupMember()
+    }
+
+    private class Performer: NSObject, ContinuousPerforming {
+      let target: Any
+      required init(target: Any) {
+        self.target = target
+      }
+
+      func addPlan(_ plan: Plan) {
+        addPlans([plan])
+      }
+
+      func addPlans(_ plans: [Plan]) {
+        let group = planTokenizer.tokenGroup!(for: plans)
+        XCTAssertEqual(group.count, plans.count)
+
+        group.isActive = true
+        XCTAssertTrue(group.isActive)
+
+        group.isActive = false
+        XCTAssertFalse(group.isActive)
+      }
+
+      var planTokenizer: PlanTokenizing!
+      func givePlanTokenizer(_ planTokenizer: PlanTokenizing) {
+        self.planTokenizer = planTokenizer
+      }
+    }
+  }
+
   private class TokenFetching: NSObject, Plan {
     func performerClass() -> AnyClass {
       return Performer.self
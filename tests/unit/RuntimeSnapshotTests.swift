@@ -0,0 +1,156 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+import XCTest
+import Foundation
+import MaterialMotionRuntime
+
+// Tests related to runtime snapshots.
+class RuntimeSnapshotTests: XCTestCase {
+
+  func testEmptyRuntimeSnapshot() {
+    let snapshot = MotionRuntime().snapshot()
+
+    XCTAssertEqual(snapshot.targetScopeCount, 0)
+    XCTAssertEqual(snapshot.performerCount, 0)
+    XCTAssertEqual(snapshot.tokenCount, 0)
+    XCTAssertEqual(snapshot.namedPlanCount, 0)
+    XCTAssertEqual(snapshot.performerCountByClassName.count, 0)
+    XCTAssertNil(snapshot.targets)
+  }
+
+  func testSnapshotCountsScopesPerformersAndNamedPlans() {
+    let runtime = MotionRuntime()
+    let first = ValuesTarget()
+    let second = ValuesTarget()
+
+    runtime.addPlan(AppendValue(value: 1), to: first)
+    runtime.addPlan(AppendValue(value: 2), to: first)
+    runtime.addPlan(NamedValue(value: 3), named: "a", to: first)
+    runtime.addPlan(NamedValue(value: 4), named: "a", to: second)
+
+    let snapshot = runtime.snapshot()
+    XCTAssertEqual(snapshot.targetScopeCount, 2)
+    XCTAssertEqual(snapshot.performerCount, 3)
+    XCTAssertEqual(snapshot.namedPlanCount, 2)
+    XCTAssertEqual(snapshot.performerCountByClassName.count, 2)
+    XCTAssertEqual(snapshot.performerCountByClassName.values.reduce(0) { $0 + $1.intValue }, 3)
+    XCTAssertEqual(snapshot.estimatedPerformerByteCountByClassName.count, 2)
+    XCTAssertGreaterThan(snapshot.estimatedByteCount, 0)
+  }
+
+  func testRemovingTheLastNamedPlanKeepsHighWaterMarks() {
+    let runtime = MotionRuntime()
+    let target = ValuesTarget()
+
+    runtime.addPlan(NamedValue(value: 1), named: "a", to: target)
+    runtime.addPlan(NamedValue(value: 2), named: "b", to: target)
+    XCTAssertEqual(runtime.snapshot().namedPlanCount, 2)
+
+    runtime.removePlan(named: "a", from: target)
+    XCTAssertEqual(runtime.snapshot().namedPlanCount, 1)
+
+    runtime.removePlan(named: "b", from: target)
+    let snapshot = runtime.snapshot()
+    XCTAssertEqual(snapshot.targetScopeCount, 0)
+    XCTAssertEqual(snapshot.performerCount, 0)
+    XCTAssertEqual(snapshot.namedPlanCount, 0)
+    XCTAssertEqual(snapshot.peakTargetScopeCount, 1)
+    XCTAssertEqual(snapshot.peakPerformerCount, 1)
+  }
+
+  func testDeallocatedTargetsAreNotCounted() {
+    let runtime = MotionRuntime()
+    let survivor = ValuesTarget()
+    runtime.addPlan(AppendValue(value: 1), to: survivor)
+
+    autoreleasepool {
+      let target = ValuesTarget()
+      runtime.addPlan(AppendValue(value: 2), to: target)
+      XCTAssertEqual(runtime.snapshot().targetScopeCount, 2)
+    }
+
+    let snapshot = runtime.snapshot()
+    XCTAssertEqual(snapshot.targetScopeCount, 1)
+    XCTAssertEqual(snapshot.performerCount, 1)
+  }
+
+  func testTargetBreakdown() {
+    let runtime = MotionRuntime()
+    let target = ValuesTarget()
+    runtime.addPlan(AppendValue(value: 1), to: target)
+    runtime.addPlan(NamedValue(value: 2), named: "a", to: target)
+
+    let snapshot = runtime.snapshot(options: .targetBreakdown)
+    XCTAssertEqual(snapshot.targets?.count, 1)
+
+    let targetSnapshot = snapshot.targets![0]
+    XCTAssertTrue(targetSnapshot.target as? ValuesTarget === target)
+    XCTAssertEqual(targetSnapshot.performerCount, 2)
+    XCTAssertEqual(targetSnapshot.namedPlanCount, 1)
+    XCTAssertEqual(targetSnapshot.estimatedByteCount, snapshot.estimatedByteCount)
+  }
+
+  func testActiveTokensAreCounted() {
+    let runtime = MotionRuntime()
+    let target = ValuesTarget()
+
+    runtime.addPlan(Activating(), to: target)
+
+    let snapshot = runtime.snapshot()
+    XCTAssertEqual(snapshot.tokenCount, 1)
+    XCTAssertEqual(snapshot.activeTokenCount, 1)
+    XCTAssertEqual(snapshot.peakActiveTokenCount, 1)
+  }
+
+  func testTracersAreCounted() {
+    let runtime = MotionRuntime()
+    runtime.addTracer(ConsoleLoggingTracer())
+
+    XCTAssertEqual(runtime.snapshot().tracerCount, 1)
+  }
+
+  private class Activating: NSObject, Plan {
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return Activating()
+    }
+
+    private class Performer: NSObject, ContinuousPerforming {
+      var plans: [Plan] = []
+      var tokens: [Tokened] = []
+
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+        // Keep the plan alive so that its token remains in the pool.
+        plans.append(plan)
+        let token = planTokenizer.token(for: plan)!
+        token.isActive = true
+        tokens.append(token)
+      }
+
+      var planTokenizer: PlanTokenizing!
+      func givePlanTokenizer(_ planTokenizer: PlanTokenizing) {
+        self.planTokenizer = planTokenizer
+      }
+    }
+  }
+}
@@ -41,6 +41,72 @@ class RuntimeTests: XCTestCase {
     XCTAssertEqual(spy.countOf(.didAddPlan(plan: ChangeBoolean.self, target: state)), 1)
   }
 
+  func testImmutablePlansAreNotCopied() {
+    let runtime = MotionRuntime()
+    let tracer = AddedPlanTracer()
+    runtime.addTracer(tracer)
+
+    let plan = ImmutableNoOp()
+    runtime.addPlan(plan, to: NSObject())
+
+    XCTAssertEqual(tracer.plans.count, 1)
+    XCTAssertTrue(tracer.plans[0] === plan)
+  }
+
+  func testCopyOnWritePlanClonesStorageOnMutation() {
+    let plan = SharedValues()
+    let copy = plan.copy() as! SharedValues
+
+    XCTAssertTrue(plan.isStorageShared)
+    XCTAssertTrue(plan.storage as AnyObject === copy.storage as AnyObject)
+
+    (copy.mutableStorage() as! NSMutableArray).add(2)
+
+    XCTAssertFalse(plan.isStorageShared)
+    XCTAssertFalse(copy.isStorageShared)
+    XCTAssertEqual(plan.storage as! NSArray, [1])
+    XCTAssertEqual(copy.storage as! NSArray, [1, 2])
+  }
+
+  private class AddedPlanTracer: NSObject, Tracing {
+    var plans: [AnyObject] = []
+    func didAddPlan(_ plan: Plan, to target: Any) {
+      plans.append(plan)
+    }
+  }
+
+  private class ImmutableNoOp: NSObject, ImmutablePlan {
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return ImmutableNoOp()
+    }
+
+    private class Performer: NSObject, Performing {
+      required init(target: Any) {
+      }
+
+      func addPlan(_ plan: Plan) {
+      }
+    }
+  }
+
+  private class SharedValues: CopyOnWritePlan, Plan {
+    init() {
+      super.init(storage: NSMutableArray(array: [1]))
+    }
+
+    override init(sharingStorageOf plan: CopyOnWritePlan) {
+      super.init(sharingStorageOf: plan)
+    }
+
+    func performerClass() -> AnyClass {
+      return NSObject.self
+    }
+  }
+
   // Verify that a plan committed to a runtime immediately executes its add(plan:) logic.
   func testAddPlanInvokedImmediately() {
     let state = State()
@@ -130,6 +196,134 @@ class RuntimeTests: XCTestCase {
     XCTAssertEqual(state.boolean, true)
   }
 
+  // Verify that a batch-capable performer receives all of its plans in one invocation.
+  func testBatchedPlansAreDeliveredInOneInvocation() {
+    let target = BatchTarget()
+
+    let runtime = MotionRuntime()
+    runtime.addPlans([BatchedValue(value: 1),
+                      BatchedValue(value: 2),
+                      BatchedValue(value: 3)], to: target)
+
+    XCTAssertEqual(target.batches.count, 1)
+    XCTAssertEqual(target.batches.first!, [1, 2, 3])
+  }
+
+  // Verify that batch-aware tracers receive a single event for a batch of plans.
+  func testBatchedPlansSendOneBatchedTracerEvent() {
+    let target = BatchTarget()
+
+    let runtime = MotionRuntime()
+    let tracer = BatchTracer()
+    runtime.addTracer(tracer)
+    let spy = RuntimeSpy()
+    runtime.addTracer(spy)
+
+    runtime.addPlans([BatchedValue(value: 1),
+                      ChangeBoolean(desiredBoolean: true),
+                      BatchedValue(value: 2)], to: target)
+
+    XCTAssertEqual(tracer.batchSizes, [3])
+    XCTAssertEqual(spy.countOf(.didAddPlan(plan: BatchedValue.self, target: target)), 2)
+    XCTAssertEqual(spy.countOf(.didCreatePerformer(target: target)), 2)
+  }
+
+  // Verify that tracers only receive events while they are registered.
+  func testRemovedTracerReceivesNoEvents() {
+    let state = State()
+
+    let runtime = MotionRuntime()
+    let spy = RuntimeSpy()
+    runtime.addTracer(spy)
+    runtime.addPlan(ChangeBoolean(desiredBoolean: true), to: state)
+    runtime.removeTracer(spy)
+    runtime.addPlan(ChangeBoolean(desiredBoolean: false), to: state)
+
+    XCTAssertEqual(spy.countOf(.didAddPlan(plan: ChangeBoolean.self, target: state)), 1)
+    XCTAssertEqual(runtime.tracers().count, 0)
+  }
+
+  // Verify that asynchronously traced events are all delivered once the tracers are flushed.
+  func testAsynchronousTracingDeliversEventsOnFlush() {
+    let state = State()
+
+    let runtime = MotionRuntime()
+    runtime.isAsynchronousTracingEnabled = true
+    let spy = RuntimeSpy()
+    runtime.addTracer(spy)
+
+    runtime.addPlan(ChangeBoolean(desiredBoolean: true), to: state)
+    runtime.addPlans([ChangeBoolean(desiredBoolean: false),
+                      ChangeBoolean(desiredBoolean: true)], to: state)
+    runtime.flushTracers()
+
+    XCTAssertEqual(spy.countOf(.didCreatePerformer(target: state)), 1)
+    XCTAssertEqual(spy.countOf(.didAddPlan(plan: ChangeBoolean.self, target: state)), 3)
+    XCTAssertEqual(runtime.droppedTraceEventCount, 0)
+  }
+
+  // Verify that the console logging tracer only formats messages that its sink consumes.
+  func testConsoleLoggingTracerFormatsLazily() {
+    var invocations = 0
+    var messages: [String] = []
+    let tracer = ConsoleLoggingTracer(sink: { formatMessage in
+      invocations += 1
+      if invocations == 2 {
+        messages.append(formatMessage())
+      }
+    })
+
+    let runtime = MotionRuntime()
+    runtime.addTracer(tracer)
+    runtime.addPlan(ChangeBoolean(desiredBoolean: true), to: State())
+
+    XCTAssertEqual(invocations, 2)
+    XCTAssertEqual(messages.count, 1)
+    XCTAssertTrue(messages[0].hasPrefix("didAddPlan to target"))
+  }
+
+  private class BatchTarget: State {
+    var batches: [[Int]] = []
+  }
+
+  private class BatchTracer: NSObject, Tracing {
+    var batchSizes: [Int] = []
+    func didAddPlans(_ plans: [Plan], to target: Any) {
+      batchSizes.append(plans.count)
+    }
+  }
+
+  private class BatchedValue: NSObject, Plan {
+    var value: Int
+
+    init(value: Int) {
+      self.value = value
+    }
+
+    func performerClass() -> AnyClass {
+      return Performer.self
+    }
+
+    public func copy(with zone: NSZone? = nil) -> Any {
+      return BatchedValue(value: value)
+    }
+
+    private class Performer: NSObject, Performing {
+      let target: BatchTarget
+      required init(target: Any) {
+        self.target = target as! BatchTarget
+      }
+
+      func addPlan(_ plan: Plan) {
+        addPlans([plan])
+      }
+
+      func addPlans(_ plans: [Plan]) {
+        target.batches.append(plans.map { ($0 as! BatchedValue).value })
+      }
+    }
+  }
+
   func testRuntimeIsDeallocatedWhenNotReferenced() {
     var runtime: MotionRuntime? = MotionRuntime()
     weak var weakRuntime: MotionRuntime? = runtime
@@ -143,4 +143,220 @@ class TimelineTests: XCTestCase {
     timeline.begin()
     XCTAssertNotNil(timeline.beginTime)
   }
+
+  func testBeginTimeIsReadFromTheTimelinesClock() {
+    let clock = VirtualClock()
+    clock.advance(by: 12.5)
+    let timeline = Timeline(clock: clock)
+
+    timeline.begin()
+
+    XCTAssertEqual(timeline.beginTime?.doubleValue, 12.5)
+  }
+
+  func testClockScrubDeliveryCoalescesScrubsUntilTheNextTick() {
+    let clock = VirtualClock()
+    let timeline = Timeline(clock: clock)
+    timeline.scrubDelivery = .clock
+
+    let spy = TimelineSpy()
+    timeline.addObserver(spy)
+
+    timeline.attachScrubber(withTimeOffset: 0)
+    let scrubber = timeline.scrubber!
+    scrubber.timeOffset = 1
+    scrubber.timeOffset = 2
+    scrubber.timeOffset = 3
+    XCTAssert(spy.events == [.didAttach])
+
+    clock.advance(by: 1.0 / 60.0)
+    XCTAssert(spy.events == [.didAttach, .didScrub(timeOffset: 3)])
+
+    clock.advance(by: 1.0 / 60.0)
+    XCTAssert(spy.events == [.didAttach, .didScrub(timeOffset: 3)])
+  }
+
+  func testClockScrubDeliveryReachesObserversAddedAfterAScrub() {
+    let clock = VirtualClock()
+    let timeline = Timeline(clock: clock)
+    timeline.scrubDelivery = .clock
+    timeline.attachScrubber(withTimeOffset: 0)
+
+    let first = TimelineSpy()
+    timeline.addObserver(first)
+    timeline.scrubber!.timeOffset = 1
+    clock.advance(by: 1.0 / 60.0)
+
+    let second = TimelineSpy()
+    timeline.addObserver(second)
+    timeline.scrubber!.timeOffset = 2
+    clock.advance(by: 1.0 / 60.0)
+
+    XCTAssert(first.events == [.didScrub(timeOffset: 1), .didScrub(timeOffset: 2)])
+    XCTAssert(second.events == [.didScrub(timeOffset: 2)])
+  }
+
+  func testDetachingDiscardsAPendingScrub() {
+    let clock = VirtualClock()
+    let timeline = Timeline(clock: clock)
+    timeline.scrubDelivery = .clock
+
+    let spy = TimelineSpy()
+    timeline.addObserver(spy)
+
+    timeline.attachScrubber(withTimeOffset: 0)
+    timeline.scrubber!.timeOffset = 1
+    timeline.detachScrubber()
+    clock.advance(by: 1.0 / 60.0)
+
+    XCTAssert(spy.events == [.didAttach, .didDetach])
+  }
+
+  func testSwitchingToImmediateScrubDeliveryDeliversThePendingScrub() {
+    let clock = VirtualClock()
+    let timeline = Timeline(clock: clock)
+    timeline.scrubDelivery = .clock
+
+    let spy = TimelineSpy()
+    timeline.addObserver(spy)
+
+    timeline.attachScrubber(withTimeOffset: 0)
+    timeline.scrubber!.timeOffset = 1
+    timeline.scrubDelivery = .immediate
+    XCTAssert(spy.events == [.didAttach, .didScrub(timeOffset: 1)])
+
+    timeline.scrubber!.timeOffset = 2
+    XCTAssert(spy.events == [.didAttach, .didScrub(timeOffset: 1), .didScrub(timeOffset: 2)])
+  }
+
+  func testCurvesAreSampledOnceAndInterpolatedOnScrub() {
+    let timeline = Timeline()
+    timeline.curveSampleRate = 4
+    let target = NSObject()
+    var evaluationCount = 0
+    var values: [Double] = []
+
+    timeline.addCurve({ timeOffset in
+      evaluationCount += 1
+      return timeOffset * timeOffset * 10
+    }, duration: 1, for: target, applier: { _, value in
+      values.append(value)
+    })
+    XCTAssertEqual(timeline.curveCount, 1)
+
+    timeline.attachScrubber(withTimeOffset: 0.5)
+    timeline.scrubber!.timeOffset = 0.625
+    timeline.scrubber!.timeOffset = 2
+    timeline.scrubber!.timeOffset = -1
+
+    // Samples at 0.5 and 0.75 are 2.5 and 5.625.
+    XCTAssertEqual(values, [2.5, 4.0625, 10, 0])
+    XCTAssertEqual(evaluationCount, 5)
+  }
+
+  func testAddingAPlanToATracedTargetResamplesItsCurves() {
+    let runtime = MotionRuntime()
+    let timeline = Timeline()
+    runtime.addTimeline(timeline)
+    let target = NSObject()
+    let otherTarget = NSObject()
+    var scale = 1.0
+    var values: [Double] = []
+    var otherEvaluationCount = 0
+
+    timeline.addCurve({ timeOffset in timeOffset * scale }, duration: 1, for: target,
+                      applier: { _, value in values.append(value) })
+    timeline.addCurve({ timeOffset in
+      otherEvaluationCount += 1
+      return timeOffset
+    }, duration: 1, for: otherTarget, applier: { _, _ in })
+
+    timeline.attachScrubber(withTimeOffset: 1)
+    scale = 2
+    timeline.scrubber!.timeOffset = 0.5
+    let otherEvaluationCountBeforePlan = otherEvaluationCount
+
+    runtime.addPlan(InstantlyInactive(), to: target)
+    timeline.scrubber!.timeOffset = 1
+
+    XCTAssertEqual(values, [1, 0.5, 2])
+    XCTAssertEqual(otherEvaluationCount, otherEvaluationCountBeforePlan)
+  }
+
+  func testRemovedCurvesAreNotApplied() {
+    let timeline = Timeline()
+    let target = NSObject()
+    var applyCount = 0
+
+    timeline.addCurve({ timeOffset in timeOffset }, duration: 1, for: target,
+                      applier: { _, _ in applyCount += 1 })
+    timeline.attachScrubber(withTimeOffset: 0.5)
+    timeline.removeCurves(for: target)
+    timeline.scrubber!.timeOffset = 1
+
+    XCTAssertEqual(applyCount, 1)
+    XCTAssertEqual(timeline.curveCount, 0)
+  }
+
+  func testCurvesAreResampledWhileTracingAsynchronously() {
+    let runtime = MotionRuntime()
+    runtime.isAsynchronousTracingEnabled = true
+    let timeline = Timeline()
+    runtime.addTimeline(timeline)
+    let target = NSObject()
+    var scale = 1.0
+    var values: [Double] = []
+
+    timeline.addCurve({ timeOffset in timeOffset * scale }, duration: 1, for: target,
+                      applier: { _, value in values.append(value) })
+    timeline.attachScrubber(withTimeOffset: 1)
+    scale = 2
+
+    // The timeline is informed of the plan before addPlan returns, without flushing the tracers.
+    runtime.addPlan(InstantlyInactive(), to: target)
+    timeline.scrubber!.timeOffset = 1
+
+    XCTAssertEqual(values, [1, 2])
+  }
+
+  func testTimelinesAreNotTracers() {
+    let runtime = MotionRuntime()
+    let timeline = Timeline()
+    runtime.addTimeline(timeline)
+    let target = NSObject()
+    var scale = 1.0
+    var values: [Double] = []
+
+    XCTAssertEqual(runtime.tracers().count, 0)
+    XCTAssertEqual(runtime.snapshot().tracerCount, 0)
+
+    timeline.addCurve({ timeOffset in timeOffset * scale }, duration: 1, for: target,
+                      applier: { _, value in values.append(value) })
+    timeline.attachScrubber(withTimeOffset: 1)
+    scale = 2
+
+    runtime.removeTimeline(timeline)
+    runtime.addPlan(InstantlyInactive(), to: target)
+    timeline.scrubber!.timeOffset = 0.5
+
+    XCTAssertEqual(values, [1, 0.5])
+  }
+
+  func testCurvesDoNotRetainTheirTarget() {
+    let timeline = Timeline()
+    var target: TimelineCurveTarget? = TimelineCurveTarget()
+    weak var weakTarget = target
+
+    timeline.addCurve({ timeOffset in timeOffset }, duration: 1, for: target!,
+                      applier: { target, value in (target as! TimelineCurveTarget).value = value })
+    timeline.attachScrubber(withTimeOffset: 0.5)
+    XCTAssertEqual(target!.value, 0.5)
+
+    target = nil
+    XCTAssertNil(weakTarget)
+  }
+}
+
+private class TimelineCurveTarget: NSObject {
+  var value = 0.0
 }
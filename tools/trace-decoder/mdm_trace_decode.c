@@ -0,0 +1,293 @@
+/*
+ Copyright 2016-present The Material Motion Authors. All Rights Reserved.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+/*
+ Decodes a capture written by MDMBinaryTraceRecorder and prints a timeline summary.
+
+ Build:   cc -O2 -o mdm_trace_decode mdm_trace_decode.c
+ Usage:   mdm_trace_decode [--events] <capture file>
+
+ --events additionally prints every retained record, oldest first.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../src/private/MDMBinaryTraceFormat.h"
+
+// Identifiers are allocated densely from 1, so strings and counters are indexed by identifier.
+
+typedef struct {
+  uint32_t identifier;
+  uint64_t count;
+} Counter;
+
+typedef struct {
+  uint64_t *counts;
+  size_t capacity;
+} CounterList;
+
+static char **stringsByIdentifier;
+static size_t stringsCapacity;
+
+static const char *stringForIdentifier(uint32_t identifier) {
+  if (identifier == 0) {
+    return "-";
+  }
+  if (identifier >= stringsCapacity || !stringsByIdentifier[identifier]) {
+    return "<unknown>";
+  }
+  return stringsByIdentifier[identifier];
+}
+
+// Returns a NUL-terminated copy of length bytes. Strings in the table are not NUL-terminated.
+static char *copyString(const char *bytes, size_t length) {
+  char *string = malloc(length + 1);
+  memcpy(string, bytes, length);
+  string[length] = '\0';
+  return string;
+}
+
+static void setStringForIdentifier(uint32_t identifier, char *string) {
+  if (identifier >= stringsCapacity) {
+    size_t capacity = stringsCapacity ? stringsCapacity : 64;
+    while (capacity <= identifier) {
+      capacity *= 2;
+    }
+    stringsByIdentifier = realloc(stringsByIdentifier, capacity * sizeof(char *));
+    memset(stringsByIdentifier + stringsCapacity, 0, (capacity - stringsCapacity) * sizeof(char *));
+    stringsCapacity = capacity;
+  }
+  stringsByIdentifier[identifier] = string;
+}
+
+static void incrementCounter(CounterList *list, uint32_t identifier) {
+  if (identifier >= list->capacity) {
+    size_t capacity = list->capacity ? list->capacity : 16;
+    while (capacity <= identifier) {
+      capacity *= 2;
+    }
+    list->counts = realloc(list->counts, capacity * sizeof(uint64_t));
+    memset(list->counts + list->capacity, 0, (capacity - list->capacity) * sizeof(uint64_t));
+    list->capacity = capacity;
+  }
+  list->counts[identifier]++;
+}
+
+static int compareCounters(const void *lhs, const void *rhs) {
+  const Counter *a = lhs;
+  const Counter *b = rhs;
+  return a->count < b->count ? 1 : (a->count > b->count ? -1 : 0);
+}
+
+// Prints the list's non-zero counters, largest first. Targets are labeled by their class name,
+// which is resolved through the targetClassIDs list indexed by target ID.
+static void printCounters(const char *title, CounterList *list, const uint32_t *targetClassIDs) {
+  printf("\n%s\n", title);
+  size_t count = 0;
+  Counter *counters = malloc((list->capacity ? list->capacity : 1) * sizeof(Counter));
+  for (size_t ix = 0; ix < list->capacity; ix++) {
+    if (list->counts[ix] > 0) {
+      counters[count].identifier = (uint32_t)ix;
+      counters[count].count = list->counts[ix];
+      count++;
+    }
+  }
+  qsort(counters, count, sizeof(Counter), compareCounters);
+  for (size_t ix = 0; ix < count; ix++) {
+    if (targetClassIDs) {
+      printf("  %10llu  %s#%u\n", (unsigned long long)counters[ix].count,
+             stringForIdentifier(targetClassIDs[counters[ix].identifier]),
+             counters[ix].identifier);
+    } else {
+      printf("  %10llu  %s\n", (unsigned long long)counters[ix].count,
+             stringForIdentifier(counters[ix].identifier));
+    }
+  }
+  free(counters);
+}
+
+static const char *eventName(uint16_t event) {
+  switch (event) {
+    case MDMBinaryTraceEventDidAddPlan:
+      return "didAddPlan";
+    case MDMBinaryTraceEventDidAddPlanNamed:
+      return "didAddPlanNamed";
+    case MDMBinaryTraceEventDidRemovePlanNamed:
+      return "didRemovePlanNamed";
+    case MDMBinaryTraceEventDidCreatePerformer:
+      return "didCreatePerformer";
+    case MDMBinaryTraceEventDidDropEmittedPlan:
+      return "didDropEmittedPlan";
+  }
+  return "unknown";
+}
+
+int main(int argc, char **argv) {
+  int printEvents = 0;
+  const char *path = NULL;
+  for (int ix = 1; ix < argc; ix++) {
+    if (strcmp(argv[ix], "--events") == 0) {
+      printEvents = 1;
+    } else {
+      path = argv[ix];
+    }
+  }
+  if (!path) {
+    fprintf(stderr, "usage: %s [--events] <capture file>\n", argv[0]);
+    return 2;
+  }
+
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    perror(path);
+    return 1;
+  }
+  fseek(file, 0, SEEK_END);
+  long fileLength = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  uint8_t *bytes = malloc((size_t)fileLength);
+  if (!bytes || fread(bytes, 1, (size_t)fileLength, file) != (size_t)fileLength) {
+    fprintf(stderr, "%s: could not read capture\n", path);
+    return 1;
+  }
+  fclose(file);
+
+  const MDMBinaryTraceHeader *header = (const MDMBinaryTraceHeader *)bytes;
+  if ((size_t)fileLength < sizeof(*header) || header->magic != MDM_BINARY_TRACE_MAGIC) {
+    fprintf(stderr, "%s: not a Material Motion trace capture\n", path);
+    return 1;
+  }
+  if (header->version != MDM_BINARY_TRACE_VERSION
+      || header->recordSize != sizeof(MDMBinaryTraceRecord)) {
+    fprintf(stderr, "%s: unsupported capture version %u\n", path, header->version);
+    return 1;
+  }
+  if (header->headerSize < sizeof(*header) || header->headerSize > (size_t)fileLength
+      || (header->recordCapacity == 0 && header->recordsWritten > 0)) {
+    fprintf(stderr, "%s: capture is corrupt\n", path);
+    return 1;
+  }
+  size_t recordsOffset = header->headerSize;
+  size_t stringsOffset = recordsOffset + (size_t)header->recordCapacity * header->recordSize;
+  if (stringsOffset + header->stringTableLength > (size_t)fileLength) {
+    fprintf(stderr, "%s: capture is truncated\n", path);
+    return 1;
+  }
+  const MDMBinaryTraceRecord *records = (const MDMBinaryTraceRecord *)(bytes + recordsOffset);
+
+  // Index the string table once so that each record resolves its names in constant time.
+  size_t offset = 0;
+  while (offset + sizeof(MDMBinaryTraceString) <= header->stringTableLength) {
+    MDMBinaryTraceString entry;
+    memcpy(&entry, bytes + stringsOffset + offset, sizeof(entry));
+    offset += sizeof(entry);
+    if (entry.length > header->stringTableLength - offset) {
+      fprintf(stderr, "%s: capture is corrupt\n", path);
+      return 1;
+    }
+    setStringForIdentifier(entry.identifier,
+                           copyString((const char *)bytes + stringsOffset + offset, entry.length));
+    offset += ((size_t)entry.length + 3) & ~(size_t)3;
+  }
+
+  uint64_t retained = header->recordsWritten < header->recordCapacity
+                          ? header->recordsWritten
+                          : header->recordCapacity;
+  uint64_t first = header->recordsWritten - retained;
+
+  uint64_t eventCounts[6] = {0};
+  CounterList planClasses = {0};
+  CounterList performerCreations = {0};
+  CounterList targets = {0};
+  CounterList planNames = {0};
+  // The class name ID of each target, indexed by target ID.
+  uint32_t *targetClassIDs = NULL;
+  size_t targetClassIDCapacity = 0;
+  uint64_t firstTimestamp = 0;
+  uint64_t lastTimestamp = 0;
+
+  if (printEvents) {
+    printf("%14s  %-18s  %-24s  %-32s  %-32s  %s\n", "time (ms)", "event", "target",
+           "plan", "performer", "name");
+  }
+  for (uint64_t n = first; n < header->recordsWritten; n++) {
+    const MDMBinaryTraceRecord *record = &records[n % header->recordCapacity];
+    if (n == first) {
+      firstTimestamp = record->timestamp;
+    }
+    lastTimestamp = record->timestamp;
+    if (record->event < 6) {
+      eventCounts[record->event]++;
+    }
+    incrementCounter(&targets, record->targetID);
+    if (record->targetID >= targetClassIDCapacity) {
+      size_t capacity = targets.capacity;
+      targetClassIDs = realloc(targetClassIDs, capacity * sizeof(uint32_t));
+      memset(targetClassIDs + targetClassIDCapacity, 0,
+             (capacity - targetClassIDCapacity) * sizeof(uint32_t));
+      targetClassIDCapacity = capacity;
+    }
+    targetClassIDs[record->targetID] = record->targetClassID;
+    switch (record->event) {
+      case MDMBinaryTraceEventDidAddPlan:
+        incrementCounter(&planClasses, record->planClassID);
+        break;
+      case MDMBinaryTraceEventDidAddPlanNamed:
+        incrementCounter(&planClasses, record->planClassID);
+        incrementCounter(&planNames, record->nameID);
+        break;
+      case MDMBinaryTraceEventDidRemovePlanNamed:
+        incrementCounter(&planNames, record->nameID);
+        break;
+      case MDMBinaryTraceEventDidCreatePerformer:
+        incrementCounter(&performerCreations, record->performerClassID);
+        break;
+    }
+    if (printEvents) {
+      char target[64];
+      snprintf(target, sizeof(target), "%s#%u", stringForIdentifier(record->targetClassID),
+               record->targetID);
+      printf("%14.3f  %-18s  %-24s  %-32s  %-32s  %s\n",
+             (double)(record->timestamp - header->startTimestamp) / 1e6,
+             eventName(record->event), target, stringForIdentifier(record->planClassID),
+             stringForIdentifier(record->performerClassID), stringForIdentifier(record->nameID));
+    }
+  }
+
+  printf("Capture: %s\n", path);
+  printf("Records: %llu retained of %llu written (capacity %u)\n", (unsigned long long)retained,
+         (unsigned long long)header->recordsWritten, header->recordCapacity);
+  if (header->flags & MDMBinaryTraceFlagStringTableOverflow) {
+    printf("Warning: the string table overflowed; some names are unknown.\n");
+  }
+  if (retained > 0) {
+    double duration = (double)(lastTimestamp - firstTimestamp) / 1e6;
+    printf("Span: %.3f ms to %.3f ms (%.3f ms)\n",
+           (double)(firstTimestamp - header->startTimestamp) / 1e6,
+           (double)(lastTimestamp - header->startTimestamp) / 1e6, duration);
+  }
+  printf("\nEvents\n");
+  for (uint16_t event = 1; event < 6; event++) {
+    printf("  %10llu  %s\n", (unsigned long long)eventCounts[event], eventName(event));
+  }
+  printCounters("Plans added by plan class", &planClasses, NULL);
+  printCounters("Performers created by class", &performerCreations, NULL);
+  printCounters("Named plan events by name", &planNames, NULL);
+  printCounters("Events by target", &targets, targetClassIDs);
+  return 0;
+}